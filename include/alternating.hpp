@@ -2,9 +2,10 @@
 
 #include "animation.hpp"
 
-class AlternatingBlink: public IterationAnimation<10, 500> {
+class AlternatingBlink: public IterationAnimation {
 public:
-  AlternatingBlink(const CRGB& firstColor, const CRGB& secondColor) : _firstColor(firstColor), _secondColor(secondColor == firstColor ? CRGB::Black : secondColor) {
+  AlternatingBlink(const CRGB& firstColor, const CRGB& secondColor)
+    : IterationAnimation(10, framesPerMs<500>()), _firstColor(firstColor), _secondColor(secondColor == firstColor ? CRGB::Black : secondColor) {
   }
 
   AlternatingBlink() : AlternatingBlink(getRandomColor(), getRandomColor()) {
@@ -13,9 +14,9 @@ public:
   ANIMATIONNAME("Alternating")
 protected:
   virtual void step() override {
-    for (uint8_t led = 0; led < NUM_LEDS; led++) {
+    for (uint8_t led = 0; led < ledCount(); led++) {
       const CRGB ledColor = ((led % 2) == (_iteration % 2)) ? _secondColor : _firstColor;
-      leds[led] = ledColor;
+      firstLed()[led] = ledColor;
     }
     IterationAnimation::step();
   }
@@ -8,15 +8,43 @@
 
 class Animation {
 public:
-  void frame() {
-    if (calculateFrame()) {
-      FastLED.show();
-    }
+  // How the frames between two steps may be calculated
+  enum class Interpolation : uint8_t {
+    None,
+    // Crossfades from the previous to the current step
+    Blend,
+    // Moves the current step towards the lower/higher indices by up to one LED
+    ShiftDown,
+    ShiftUp,
+  };
+
+  // Calculates the next frame and returns whether the LEDs need to be shown
+  bool frame() {
+    return calculateFrame();
   }
   virtual bool finished() = 0;
 
   virtual bool clearOnStart() const { return true; }
 
+  // Called when the animation is shown, after the LEDs have been cleared.
+  // Animations may be constructed in advance, so they must not touch leds[]
+  // before this. They draw on the ledCount() LEDs from firstLed(), which are
+  // only a span of the strip in a zone.
+  virtual void start() {}
+
+  // Called after a calculated frame has been sent to the LEDs
+  virtual void frameShown() {}
+
+  virtual Interpolation interpolation() const { return Interpolation::None; }
+
+  // Time since the last step, 0 directly after it and 256 when the next step is due
+  virtual uint16_t stepProgress() const { return 0; }
+
+  // Number of the following frames which will neither step nor change the
+  // LEDs. Instead of calculating them, they can be passed with skipFrames().
+  virtual uint8_t idleFrames() const { return 0; }
+  virtual void skipFrames(const uint8_t frames) {}
+
   // TODO: Improve in such a way, that it cannot be nullptr
   virtual const char* name() const = 0;
 protected:
@@ -35,32 +63,41 @@ protected:
   virtual bool calculateFrame() = 0;
 };
 
-template<uint16_t frameDelay>
+// Makes a step every few frames. The delay is a member instead of a template
+// parameter, so that the code exists only once for all animations.
 class FrameAnimation: public Animation {
+public:
+  virtual uint16_t stepProgress() const override;
+  virtual uint8_t idleFrames() const override;
+  virtual void skipFrames(const uint8_t frames) override;
 protected:
-  uint8_t _frame = 0;
+  // The delay is in frames, framesPerMs<milliseconds>() checks it at compile time
+  explicit FrameAnimation(const uint8_t frameDelay) : _frameDelay(frameDelay) {}
 
-  virtual bool calculateFrame() override {
-    if (_frame < framesPerMs<frameDelay>()) {
-      _frame++;
-      if (_frame == 1) {
-        step();
-        return true;
-      } else {
-        return false;
-      }
-    } else {
-      _frame = 0;
-      return false;
-    }
-  }
+  virtual bool calculateFrame() override;
 
   virtual void step() = 0;
+private:
+  const uint8_t _frameDelay;
+  uint8_t _frame = 0;
 };
 
 class DynamicFrameAnimation: public Animation {
 public:
   DynamicFrameAnimation(const uint16_t inital_delay_ms) : _next_delay(Animation::framesPerMs(inital_delay_ms)) {}
+
+  virtual uint16_t stepProgress() const override {
+    const uint8_t elapsed = _frame == 0 ? _next_delay : _frame - 1;
+    return (uint16_t)elapsed * 256 / (_next_delay + 1);
+  }
+
+  virtual uint8_t idleFrames() const override {
+    return _frame == 0 ? 0 : _next_delay - _frame + 1;
+  }
+
+  virtual void skipFrames(const uint8_t frames) override {
+    _frame = _frame + frames > _next_delay ? 0 : _frame + frames;
+  }
 protected:
   virtual bool calculateFrame() override {
     if (_frame < _next_delay) {
@@ -86,36 +123,43 @@ private:
   uint8_t _next_delay;
 };
 
-template<uint8_t iterationCount, uint16_t frameDelay>
-class IterationAnimation: public FrameAnimation<frameDelay> {
+class IterationAnimation: public FrameAnimation {
 public:
   virtual bool finished() override {
-    return _iteration >= iterationCount;
+    return _iteration >= _iterationCount;
   }
 protected:
+  IterationAnimation(const uint8_t iterationCount, const uint8_t frameDelay)
+    : FrameAnimation(frameDelay), _iterationCount(iterationCount) {}
+
   uint8_t _iteration = 0;
 
   virtual void step() override {
     _iteration += 1;
   }
 
-  constexpr uint8_t iteration_count() { return iterationCount; }
+  uint8_t iteration_count() const { return _iterationCount; }
+private:
+  const uint8_t _iterationCount;
 };
 
-class GlitterBlink: public IterationAnimation<20, 50> {
+class GlitterBlink: public IterationAnimation {
 public:
+  GlitterBlink() : IterationAnimation(20, framesPerMs<50>()) {}
+
   virtual bool finished() override {
-    return (_iteration >= iteration_count()) && (_newSpecs = glitterSpecs);
+    return (_iteration >= iteration_count()) && (_newSpecs = glitterSpecs());
   }
 
   ANIMATIONNAME("Glitter")
 protected:
   virtual void step() override {
-    _newSpecs = glitterSpecs;
-    for (uint8_t led = 0; led < NUM_LEDS; led++) {
-      if (leds[led] != CRGB(0, 0, 0)) {
-        if (random8() < 150) {
-          leds[led] = CRGB::Black;
+    CRGB* const strip = firstLed();
+    _newSpecs = glitterSpecs();
+    for (uint8_t led = 0; led < ledCount(); led++) {
+      if (strip[led] != CRGB(0, 0, 0)) {
+        if (randomByte() < 150) {
+          strip[led] = CRGB::Black;
         } else {
           _newSpecs--;
         }
@@ -123,13 +167,13 @@ protected:
     }
     if (_iteration > 0) {
       while (_newSpecs-- > 0) {
-        leds[random8(NUM_LEDS)] = CRGB::White;
+        strip[randomBelow(ledCount())] = CRGB::White;
       }
     }
     IterationAnimation::step();
   }
 private:
-  static constexpr uint8_t glitterSpecs = NUM_LEDS / 5;
+  static uint8_t glitterSpecs() { return ledCount() / 5; }
 
-  uint8_t _newSpecs = glitterSpecs;
+  uint8_t _newSpecs { glitterSpecs() };
 };
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "animation.hpp"
+#include "config.hpp"
 #include <new>
+#include <string.h>
 
 class AnimationBuffer {
 public:
@@ -21,11 +23,33 @@ public:
     new (_animationData) T(args...);
     _created = true;
   }
+
+  static constexpr uint16_t capacity() { return animationDataSize; }
+
+  // The raw state of the animation, to continue it after a reset
+  const uint8_t* data() const { return _animationData; }
+
+  // Overwrites the created animation with a copy of the same type and build.
+  // Returns false when the copy starts with a different vtable.
+  bool restore(const uint8_t* data) {
+    if (!_created || memcmp(_animationData, data, sizeof(void*)) != 0) {
+      return false;
+    }
+    memcpy(_animationData, data, animationDataSize);
+    return true;
+  }
 private:
-  // largest size of any animation class, maybe this can be automated?
-  static constexpr uint8_t animationDataSize = 204;
+  // largest size of any animation class, tools/resource_report.py prints the
+  // actual sizes for every environment. The pointers of the host are larger,
+  // tools/simulator needs more. With PREFETCH_AVAILABLE RotationAnimation
+  // carries its whole canvas.
+#ifdef SIMULATOR
+  static constexpr uint16_t animationDataSize = 336;
+#elif defined(ARDUINO_ARCH_ESP32)
+  static constexpr uint16_t animationDataSize = 328;
+#else
+  static constexpr uint16_t animationDataSize = 204;
+#endif
   uint8_t _animationData[animationDataSize];
   bool _created { false };
 };
-
-AnimationBuffer animationBuffer;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "config.hpp"
+
+#ifdef AUDIO_AVAILABLE
+
+#include <Arduino.h>
+#include <freertos/task.h>
+
+#include "audioanalyzer.hpp"
+
+// Captures the microphone with two DMA buffers of one block each, so that
+// one is filled while the other is analyzed. The analysis runs in its own
+// task on core 0, the animations are rendered on core 1.
+class AudioInput {
+public:
+  void begin();
+
+  // Copies the latest band levels, returns the number of beats so far
+  uint32_t read(uint8_t (&bands)[AudioAnalyzer::BANDS]);
+
+  // Average time to analyze one block
+  uint32_t processUs() const { return _processUs; }
+private:
+  AudioAnalyzer _analyzer;
+  int32_t _raw[AudioAnalyzer::SIZE];
+  int16_t _samples[AudioAnalyzer::SIZE];
+
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  uint8_t _bands[AudioAnalyzer::BANDS] = {};
+  uint32_t _beats { 0 };
+  volatile uint32_t _processUs { 0 };
+
+  static void taskLoop(void* parameters);
+  void run();
+};
+
+extern AudioInput audioInput;
+
+#endif // AUDIO_AVAILABLE
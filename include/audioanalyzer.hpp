@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+// Splits blocks of microphone samples into frequency bands with a fixed point
+// FFT and detects beats in the bass. It does not depend on the Arduino
+// framework, so tools/audio_benchmark.cpp runs it on the host with WAV files.
+// All buffers are members, nothing is allocated while processing.
+class AudioAnalyzer {
+public:
+  static constexpr uint16_t SAMPLE_RATE = 16000;
+  static constexpr uint8_t LOG2_SIZE = 8;
+  // Samples per block, the bins are 62.5 Hz apart
+  static constexpr uint16_t SIZE = 1 << LOG2_SIZE;
+  static constexpr uint8_t BANDS = 8;
+
+  struct Result {
+    // Level of each band (bass first) relative to its recent peak
+    uint8_t bands[BANDS];
+    bool beat;
+  };
+
+  AudioAnalyzer();
+
+  void process(const int16_t* samples, Result& result);
+
+  // In place radix-2 FFT of Q15 values. Every stage halves the values, so the
+  // result is the transform divided by SIZE.
+  void transform(int16_t* real, int16_t* imaginary) const;
+private:
+  // Blocks after a beat before the next one can be detected (about 130 ms)
+  static constexpr uint8_t BEAT_HOLD_BLOCKS = 8;
+
+  // Hann window and the first quarter of a sine wave, both Q15
+  int16_t _window[SIZE / 2];
+  int16_t _sine[SIZE / 4 + 1];
+
+  int16_t _real[SIZE];
+  int16_t _imaginary[SIZE];
+
+  uint16_t _peaks[BANDS];
+  uint32_t _bassAverage { 0 };
+  uint8_t _beatHold { 0 };
+
+  int16_t sine(uint16_t index) const;
+  int16_t cosine(uint16_t index) const { return sine(index + SIZE / 4); }
+};
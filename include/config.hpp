@@ -5,20 +5,117 @@
 // Enable to add motor specific code and settings
 // #define MOTOR_AVAILABLE
 
+// Enable to add an I2S microphone (like the INMP441) for the music animations
+// #define AUDIO_AVAILABLE
+
+#if defined(AUDIO_AVAILABLE) && !defined(ARDUINO_ARCH_ESP32)
+#error "The music animations need an ESP32"
+#endif
+
+// Continue the running animation after a reset, the checkpoint takes about
+// 220 bytes on AVR and 650 bytes of RTC memory on the ESP32
+#define RESUME_AVAILABLE
+
+#ifdef ARDUINO_ARCH_ESP32
+// The AVR boards do not have enough RAM for the additional frame buffers
+#define TRANSITIONS_AVAILABLE
+#define ZONES_AVAILABLE
+#define INTERPOLATION_AVAILABLE
+// Nor for a second AnimationBuffer, in which the next animation is
+// constructed while the current one is idle
+#define PREFETCH_AVAILABLE
+// Nor for the output buffer, into which the frames are rendered with gamma and
+// 16 bit brightness. Without it FastLED scales and dithers every pixel of
+// leds[] while it sends them.
+#define OUTPUT_STAGE_AVAILABLE
+#endif
+
 namespace Config
 {
 
 static constexpr uint8_t MAX_BRIGHTNESS = 0x30;
+// Output of the frames: a gamma of 2.25 (only with OUTPUT_STAGE_AVAILABLE), the
+// color correction of a typical strip (like FastLED's TypicalLEDStrip) and
+// dithering of the levels between the 8 bit steps over successive frames
+static constexpr bool GAMMA_CORRECTION = true;
+static constexpr uint32_t COLOR_CORRECTION = 0xFFB0F0;
+static constexpr bool TEMPORAL_DITHERING = true;
+// Current the strip may draw, frames above are dimmed. 0 only estimates it.
+static constexpr uint16_t POWER_BUDGET_MA = 0;
 static constexpr bool USE_EXTENDED_UNIQUE_IDS = true;
 
+// Weight of every animation until it is changed, and how many of the last
+// animations are not selected again
+static constexpr uint8_t DEFAULT_ANIMATION_WEIGHT = 10;
+static constexpr uint8_t PLAYLIST_NO_REPEAT = 2;
+// A fixed order of animations can only be set on the ESP32
+#ifdef ARDUINO_ARCH_ESP32
+static constexpr uint8_t PLAYLIST_MAX_SEQUENCE = 16;
+#else
+static constexpr uint8_t PLAYLIST_MAX_SEQUENCE = 1;
+#endif
+
+// Mounting of the strip: angle of the first LED (256 for a full circle,
+// clockwise from the top) and the direction of the indices
+static constexpr uint8_t FIRST_LED_ANGLE = 0;
+static constexpr bool LEDS_COUNTERCLOCKWISE = false;
+
 #ifdef MOTOR_AVAILABLE
 static constexpr uint8_t MIN_SPEED = 0x60;
 static constexpr uint8_t MAX_SPEED = 0xe0;
 static constexpr uint8_t ACCELERATION_SECONDS = 2;
 static constexpr uint8_t STOP_EVERY_N_SECONDS = 60;
 static constexpr uint8_t STOP_FOR_N_SECONDS = 10;
+// Accelerate along an S-curve instead of linearly
+static constexpr bool MOTOR_S_CURVE = true;
+// Time for one revolution of the wheel at MAX_SPEED
+static constexpr uint16_t MOTOR_REVOLUTION_MS = 20000;
+// Pin of a sensor which pulses once per revolution, -1 when there is none
+static constexpr int8_t MOTOR_INDEX_PIN = -1;
+// Whether the wheel turns in the direction of lower LED indices
+static constexpr bool MOTOR_TURNS_BACKWARDS = false;
+// How the phase locked patterns move relative to the wheel: 1 keeps them
+// stationary, 2 turns them backwards with the speed of the wheel
+static constexpr uint8_t PHASE_LOCK_TURNS = 1;
 
 static constexpr uint8_t MOTOR_PIN = 13;
 #endif // MOTOR_AVAILABLE
 
+#ifdef ARDUINO_ARCH_ESP32
+// How often the diagnostic sensors are published
+static constexpr uint8_t DIAGNOSTICS_INTERVAL_S = 60;
+// Live preview of the frames, averaged into that many buckets
+static constexpr uint16_t PREVIEW_INTERVAL_MS = 200;
+static constexpr uint8_t PREVIEW_BUCKETS = 33;
+#endif // ARDUINO_ARCH_ESP32
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR)
+// External pixel streams (DDP and E1.31/sACN)
+static constexpr uint16_t STREAM_DDP_PORT = 4048;
+static constexpr uint16_t STREAM_E131_UNIVERSE = 1;
+// Return to the animations, when no frame was received for that long
+static constexpr uint16_t STREAM_TIMEOUT_MS = 2500;
+// Synchronized wheels: the leader announces an animation that long before it
+// starts, a follower waits that long for the announcement after its animation
+// finished
+static constexpr uint16_t SYNC_PORT = 4049;
+static constexpr uint16_t SYNC_START_DELAY_MS = 100;
+static constexpr uint16_t SYNC_FOLLOW_WAIT_MS = 500;
+#endif // ARDUINO_ARCH_ESP32 || SIMULATOR
+
+#ifdef AUDIO_AVAILABLE
+static constexpr uint8_t AUDIO_SCK_PIN = 26;
+static constexpr uint8_t AUDIO_WS_PIN = 25;
+static constexpr uint8_t AUDIO_SD_PIN = 33;
+#endif // AUDIO_AVAILABLE
+
+#ifdef TRANSITIONS_AVAILABLE
+static constexpr uint16_t TRANSITION_MS = 1000;
+#endif // TRANSITIONS_AVAILABLE
+
+#ifdef ZONES_AVAILABLE
+// Number of equal sectors, which show their own animations when zones are enabled
+static constexpr uint8_t ZONE_COUNT = 3;
+#endif // ZONES_AVAILABLE
+
 }
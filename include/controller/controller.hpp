@@ -8,6 +8,9 @@
 #include "leds.hpp"
 
 #include "config.hpp"
+#ifdef PREFETCH_AVAILABLE
+#include <atomic>
+#endif // PREFETCH_AVAILABLE
 
 #include "animation.hpp"
 #include "alternating.hpp"
@@ -17,14 +20,47 @@
 #include "sprinkle.hpp"
 #include "stacks.hpp"
 #include "rotation.hpp"
+#include "sequence.hpp"
+#include "waves.hpp"
+#ifdef ARDUINO_ARCH_ESP32
+#include "script.hpp"
+#endif
+#ifdef AUDIO_AVAILABLE
+#include "music.hpp"
+#endif
 
 #include "animationbuffer.hpp"
+#include "transition.hpp"
+#include "interpolation.hpp"
+#include "governor.hpp"
+#include "output.hpp"
+#include "power.hpp"
+#include "playlist.hpp"
+#include "resume.hpp"
+#include "zone.hpp"
 
 namespace Ferriswheel
 {
 
 typedef void (*publish_animation_t)(const Animation* animation);
 
+// Animations which are only available on some platforms
+#ifdef AUDIO_AVAILABLE
+#define AUDIO_ANIMATIONS_LIST \
+    X(BandBarsAnimation)      \
+    X(BeatSprinkleAnimation)
+#else
+#define AUDIO_ANIMATIONS_LIST
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+#define PLATFORM_ANIMATIONS_LIST \
+    X(ScriptAnimation)           \
+    AUDIO_ANIMATIONS_LIST
+#else
+#define PLATFORM_ANIMATIONS_LIST
+#endif
+
 #define ENABLED_ANIMATIONS_LIST \
     X(AlternatingBlink)         \
     X(GlitterBlink)             \
@@ -33,7 +69,49 @@ typedef void (*publish_animation_t)(const Animation* animation);
     X(MoveAnimation)            \
     X(SprinkleAnimation)        \
     X(FallingStacks)            \
-    X(RotationAnimation)
+    X(RotationAnimation)        \
+    X(SequenceAnimation)        \
+    PLATFORM_ANIMATIONS_LIST    \
+    X(WavingColors)             \
+    X(ShootingStars)
+
+// Position of each animation in ENABLED_ANIMATIONS_LIST
+enum AnimationId : uint8_t {
+#define X(field) field##Id,
+ENABLED_ANIMATIONS_LIST
+#undef X
+  ANIMATION_COUNT
+};
+
+// Creates an animation with its default settings, or random ones where it has them
+template<class T>
+void createAnimationOfType(AnimationBuffer& buffer) {
+  buffer.create<T>();
+}
+
+template<>
+inline void createAnimationOfType<RotationAnimation>(AnimationBuffer& buffer) {
+  RotationAnimation::createRandom(buffer);
+}
+
+template<>
+inline void createAnimationOfType<SequenceAnimation>(AnimationBuffer& buffer) {
+  buffer.create<SequenceAnimation>(SequenceAnimation::randomSequence());
+}
+
+// Whether an animation has everything it needs to show something
+template<class T>
+bool animationAvailable() {
+  return true;
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+// Without an uploaded program it would only flash black
+template<>
+inline bool animationAvailable<ScriptAnimation>() {
+  return scriptProgram.loaded();
+}
+#endif
 
 template<uint8_t DATA_PIN>
 class Controller {
@@ -49,31 +127,155 @@ public:
   const bool nextAnimationRequested() const { return _nextAnimationRequested; }
 
   virtual void setAnimationsEnabled(bool enabled) { _animationsEnabled = enabled; }
+
+  // Brightness of the frames, 0xff is MAX_BRIGHTNESS, unless they exceed the power budget
+  const uint8_t brightness() const { return _brightness; }
+  void setBrightness(uint8_t brightness) { _brightness = brightness; }
+
+  // Whether the animation task continues an animation that was interrupted by a reset
+  bool resumable() const {
+#ifdef RESUME_AVAILABLE
+    return _resume.available();
+#else
+    return false;
+#endif // RESUME_AVAILABLE
+  }
   void requestNextAnimation() { _nextAnimationRequested = true; }
 
 #ifdef MOTOR_AVAILABLE
   const bool motorEnabled() const { return _motorEnabled; }
-  void setMotorEnabled(bool enabled) { _motorEnabled = enabled; }
+  virtual void setMotorEnabled(bool enabled) { _motorEnabled = enabled; }
 #endif // MOTOR_AVAILABLE
 
+#ifdef ZONES_AVAILABLE
+  const bool zonesEnabled() const { return _zonesEnabled; }
+  void setZonesEnabled(bool enabled) { _zonesEnabled = enabled; }
+#endif // ZONES_AVAILABLE
+
   void onPublishAnimation(publish_animation_t handler) { _publishAnimation = handler; }
 
 #define X(field) \
   bool is##field##Enabled() const { return _enabled##field; } \
-  void set##field##Enabled(bool enabled) { _enabled##field = enabled; }
+  void set##field##Enabled(bool enabled) { _enabled##field = enabled; playlistChanged(); }
 
 ENABLED_ANIMATIONS_LIST
 #undef X
 
+  // How often an animation is selected relative to the others, 0 never
+  const uint8_t animationWeight(uint8_t id) const { return _weights[id]; }
+  virtual void setAnimationWeight(uint8_t id, uint8_t weight) {
+    if (id < ANIMATION_COUNT) {
+      _weights[id] = weight;
+      playlistChanged();
+    }
+  }
+
+  // Shows the animations in this order instead of randomly, an empty sequence
+  // returns to the random order
+  virtual void setSequence(const uint8_t* ids, uint8_t length) {
+    _pendingSequenceLength = min(length, Config::PLAYLIST_MAX_SEQUENCE);
+    memcpy(_pendingSequence, ids, _pendingSequenceLength);
+    _sequenceChanged = true;
+    discardPrefetchedAnimation();
+  }
+
 protected:
   virtual void delayFrame() = 0;
 
-  void animationLoop(Animation& animation) {
-    if (animation.clearOnStart()) {
-      allBlack();
+  // Allows a platform to show an animation from an external source instead of
+  // the randomly selected ones.
+  virtual bool externalAnimationPending() { return false; }
+  virtual bool createExternalAnimation(AnimationBuffer& buffer) { return false; }
+
+  // Prints how much of the RAM and stacks was used so far
+  virtual void reportResources() {}
+
+  // Called after every frame of the animation loop. showUs is 0 unless a new
+  // frame was shown, a refresh of a dithered frame does not count. dropped is
+  // set when a changed frame could not be shown yet.
+  virtual void frameCompleted(const FrameGovernor& governor, uint32_t showUs, bool dropped) {}
+
+  // Called by the animation task after a new frame was sent to the strip,
+  // moved by rotation LEDs like the output. Not called when a dithered frame
+  // is only shown again.
+  virtual void ledsShown(uint8_t rotation) {}
+
+  // Called by the animation task with the average current after every animation
+  virtual void animationPowerMeasured(uint16_t averageMilliamps) {}
+
+  // Called by the animation task when the governor changed the level
+  virtual void frameLevelChanged(FrameGovernor::Level level) {}
+
+  // Number of LEDs the frame is moved towards the start when it is shown
+  virtual uint8_t outputRotation() { return 0; }
+
+  // Whether the animations must be reproducible from the random seed they were
+  // created with. Then nothing else may draw random numbers while they run, so
+  // the next one is not prefetched and there are no transitions.
+  virtual bool synchronized() { return false; }
+
+  // A refresh shows the same frame again, to let the dithering average out
+  void showLeds(bool refresh = false) {
+    const uint32_t start = micros();
+    const uint8_t rotation = outputRotation();
+    const uint16_t scale = (uint32_t)_brightness * Config::MAX_BRIGHTNESS * 0x101 / 0xff;
+    renderOutput(rotation, scale);
+    const uint16_t limited = _power.limit(_output.sums(), scale);
+#ifdef OUTPUT_STAGE_AVAILABLE
+    if (limited != scale) {
+      renderOutput(rotation, limited);
     }
+#else
+    FastLED.setBrightness(limited >> 8);
+#endif // OUTPUT_STAGE_AVAILABLE
+    const uint32_t rendered = micros();
+    FastLED.show();
+    const uint32_t end = micros();
+    _renderUs = max(_renderUs, rendered - start);
+    _shownRotation = rotation;
+    if (!refresh) {
+      _showUs = end - rendered;
+      ledsShown(rotation);
+    }
+  }
+
+  void renderOutput(uint8_t rotation, uint16_t scale) {
+    _output.setScale(scale);
+#ifdef OUTPUT_STAGE_AVAILABLE
+    // Animations work on leds[], the strip is sent the rendered outputLeds[]
+    _output.render(reinterpret_cast<const uint8_t*>(leds), reinterpret_cast<uint8_t*>(outputLeds), NUM_LEDS, rotation);
+#else
+    // FastLED scales leds[] while sending it, only the ESP32 rotates the frames
+    _output.measure(reinterpret_cast<const uint8_t*>(leds), NUM_LEDS);
+#endif // OUTPUT_STAGE_AVAILABLE
+  }
+
+  // The next animation is created again, when the settings it depends on changed.
+  // Called by other tasks, so only the animation task writes _prefetched.
+  void discardPrefetchedAnimation() { _prefetchGeneration++; }
+
+  // The playlist is rebuilt by the animation task, before it selects the next animation
+  void playlistChanged() {
+    _weightsChanged = true;
+    discardPrefetchedAnimation();
+  }
+
+  // A resumed animation continues with the canvas of the checkpoint
+  void animationLoop(Animation& animation, Animation* previous, bool resumed) {
+    _transition.begin(synchronized() || resumed ? nullptr : previous);
+    if (!resumed) {
+      if (animation.clearOnStart()) {
+        allBlack();
+      }
+      animation.start();
+    }
+    _interpolator.begin(animation);
+    _power.resetStatistics();
+    _renderUs = 0;
+    bool showPending = resumed;
     while (_animationsEnabled) {
       delayFrame();
+      _governor.begin();
       // FIXME: This should be overhauled, as this leads to code which changed
       //        something in frame(), only to determine that it has finished.
       //        When an animation made one step there it would be only visible for
@@ -82,27 +284,103 @@ protected:
       //        just check it 10ms later on the next iteration. A better solution
       //        is probably to add something to FrameAnimation, so that finished()
       //        changes on the last tick before the next frame is calculated.
-      animation.frame();
-      if (_nextAnimationRequested || animation.finished()) {
+      bool changed;
+      if (_transition.active()) {
+        changed = _transition.frame(animation);
+        if (!_transition.active()) {
+          // The LEDs contain only the canvas of the incoming animation now
+          _interpolator.begin(animation);
+        }
+      } else {
+        const bool stepped = _interpolator.frame(animation);
+        changed = stepped || _interpolator.active();
+#ifdef PREFETCH_AVAILABLE
+        if (!stepped && !synchronized()) {
+          prefetchAnimation();
+        }
+#endif // PREFETCH_AVAILABLE
+      }
+      // A frame which is not shown now, is shown with the next allowed one
+      showPending |= changed || outputRotation() != _shownRotation;
+      _showUs = 0;
+      if (showPending && _governor.showAllowed()) {
+        showLeds();
+        animation.frameShown();
+        showPending = false;
+        saveResumePoint();
+      } else if (_output.dithering() && _governor.effectsAllowed()) {
+        // The dithered levels only average out, while the frame is shown
+        // repeatedly. Only the output stage of the ESP32 dithers.
+        showLeds(true);
+      }
+      if (_governor.end()) {
+        applyFrameLevel();
+      }
+      frameCompleted(_governor, _showUs, showPending);
+      // External animations are not interrupted by the zones
+      if (_nextAnimationRequested || animation.finished() || externalAnimationPending() ||
+          (zoneLoopRequested() && _currentId != ANIMATION_COUNT)) {
         _nextAnimationRequested = false;
-        return;
+        break;
       }
     }
+    _transition.cancel();
+    _interpolator.end();
+    reportPower();
+  }
+
+  void reportPower() {
+    Serial.print("Estimated current: ");
+    Serial.print(_power.averageMilliamps());
+    Serial.print(" mA average, ");
+    Serial.print(_power.maximumMilliamps());
+    Serial.print(" mA maximum, ");
+    Serial.print(_power.limitedFrames());
+    Serial.println(" frames limited");
+    Serial.print("Output rendered in ");
+    Serial.print(_renderUs);
+    Serial.println(" us maximum");
+    animationPowerMeasured(_power.averageMilliamps());
   }
 
   void outsideLoop() {
+    bool resumed = resumeAnimation(*_nextBuffer);
     while (true) {
       if (!_animationsEnabled) {
+        resumed = false;
+        clearResumePoint();
         publishAnimation(nullptr);
         allBlack();
-        FastLED.show();
+        showLeds();
         while (!_animationsEnabled) {
           delayFrame();
         }
       }
 
-      if (createAnimation()) {
-        Animation& animation = *animationBuffer.get();
+#ifdef ZONES_AVAILABLE
+      // Streamed and synchronized animations are shown instead of the zones
+      if (_zonesEnabled && !externalAnimationPending()) {
+        resumed = false;
+        clearResumePoint();
+        zoneLoop();
+        continue;
+      }
+#endif // ZONES_AVAILABLE
+
+      const bool external = !resumed && createExternalAnimation(*_nextBuffer);
+      if (resumed || external || prefetchAnimation()) {
+        // The animation was already constructed in the spare buffer
+        AnimationBuffer* const previous = _currentBuffer;
+        _currentBuffer = _nextBuffer;
+        _nextBuffer = previous;
+        _prefetched = false;
+        // External animations cannot be created again after a reset
+        _currentId = external ? ANIMATION_COUNT : _prefetchedId;
+        if (external) {
+          clearResumePoint();
+        }
+
+        Animation& animation = *_currentBuffer->get();
         const char* name = animation.name();
         publishAnimation(&animation);
         if (name) {
@@ -111,13 +389,189 @@ protected:
         } else {
           Serial.println("Selected animation without name.");
         }
-        animationLoop(animation);
+        reportResources();
+        // With a single buffer the previous animation was replaced
+        animationLoop(animation, _nextBuffer != _currentBuffer ? _nextBuffer->get() : nullptr, resumed);
+        resumed = false;
       } else {
         publishAnimation(nullptr);
       }
     }
   }
+
+#ifdef ZONES_AVAILABLE
+  // Runs independent animations in the sectors of the wheel. Each one draws
+  // into its span of leds[] when it steps, the frame is shown once.
+  void zoneLoop() {
+    for (uint8_t zone = 0; zone < Config::ZONE_COUNT; zone++) {
+      const uint8_t offset = zone * NUM_LEDS / Config::ZONE_COUNT;
+      const uint8_t end = (zone + 1) * NUM_LEDS / Config::ZONE_COUNT;
+      _zones[zone].begin({ offset, (uint8_t)(end - offset) });
+    }
+    bool showPending = false;
+    while (_zonesEnabled && _animationsEnabled && !externalAnimationPending()) {
+      delayFrame();
+      _governor.begin();
+      if (_nextAnimationRequested) {
+        _nextAnimationRequested = false;
+        for (Zone& zone : _zones) {
+          zone.stop();
+        }
+      }
+      bool changed = false;
+      for (Zone& zone : _zones) {
+        if (!zone.advance()) {
+          continue;
+        }
+        zone.view();
+        Animation* animation = zone.animation();
+        if (animation == nullptr || animation->finished()) {
+          zone.stop();
+          if (!createAnimation(zone.buffer())) {
+            continue;
+          }
+          zone.start();
+          Serial.print("Selected zone animation: ");
+          Serial.println(zone.animation()->name());
+        }
+        changed |= zone.frame();
+      }
+      viewWholeStrip();
+      // A skipped frame is shown with the next allowed one like in animationLoop()
+      showPending |= changed || outputRotation() != _shownRotation;
+      _showUs = 0;
+      const bool show = showPending && _governor.showAllowed();
+      if (show || (_output.dithering() && _governor.effectsAllowed())) {
+        showLeds(!show);
+        showPending &= !show;
+      }
+      if (_governor.end()) {
+        applyFrameLevel();
+      }
+      frameCompleted(_governor, _showUs, showPending);
+    }
+    for (Zone& zone : _zones) {
+      zone.stop();
+    }
+  }
+#endif // ZONES_AVAILABLE
+
+  // Optional effects are only used, while the frames fit into their budget
+  void applyFrameLevel() {
+    const FrameGovernor::Level level = _governor.level();
+    _transition.setEnabled(_governor.effectsAllowed());
+    _interpolator.setEnabled(_governor.effectsAllowed());
+    Serial.print("Frame budget level: ");
+    Serial.println(static_cast<uint8_t>(level));
+    frameLevelChanged(level);
+  }
+
+  bool zoneLoopRequested() const {
+#ifdef ZONES_AVAILABLE
+    return _zonesEnabled;
+#else
+    return false;
+#endif // ZONES_AVAILABLE
+  }
+
+  // Whether the animation is enabled, has a weight and is available
+  bool animationSelectable(uint8_t id) const {
+#define X(field)                                                                 \
+    if (id == field##Id) {                                                       \
+      return _enabled##field && _weights[id] > 0 && animationAvailable<field>(); \
+    }
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+    return false;
+  }
+
+  // Picks one of the enabled animations, ANIMATION_COUNT when there is none
+  uint8_t selectAnimation() {
+    if (_weightsChanged) {
+      _weightsChanged = false;
+      uint8_t weights[ANIMATION_COUNT];
+#define X(field) \
+      weights[field##Id] = _enabled##field && animationAvailable<field>() ? _weights[field##Id] : 0;
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+      _playlist.rebuild(weights);
+    }
+    if (_sequenceChanged) {
+      _sequenceChanged = false;
+      _playlist.setSequence(_pendingSequence, _pendingSequenceLength);
+    }
+
+    const uint8_t id = _playlist.next();
+    if (id == ANIMATION_COUNT) {
+      Serial.println("No animation enabled");
+    } else {
+      Serial.print("Selected animation ");
+      Serial.println(id);
+    }
+    return id;
+  }
+
+  // Creates the animation at that position of ENABLED_ANIMATIONS_LIST, whether
+  // it is enabled or not
+  bool createAnimation(AnimationBuffer& buffer, uint8_t id) {
+    switch (id) {
+#define X(field)                            \
+    case field##Id:                         \
+      createAnimationOfType<field>(buffer); \
+      return true;
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+    default:
+      return false;
+    }
+  }
+
 private:
+#ifdef PREFETCH_AVAILABLE
+  // The current animation and the next one, which is constructed while the
+  // current one is idle.
+  AnimationBuffer _animationBuffers[2];
+  AnimationBuffer* _currentBuffer { &_animationBuffers[0] };
+  AnimationBuffer* _nextBuffer { &_animationBuffers[1] };
+#else
+  // The next animation replaces the current one, when that one ended
+  AnimationBuffer _animationBuffers[1];
+  AnimationBuffer* _currentBuffer { &_animationBuffers[0] };
+  AnimationBuffer* _nextBuffer { &_animationBuffers[0] };
+#endif // PREFETCH_AVAILABLE
+  bool _prefetched { false };
+  // Counts the discards, the prefetched animation is only used while no other
+  // one happened since it was selected
+#ifdef PREFETCH_AVAILABLE
+  std::atomic<uint8_t> _prefetchGeneration { 0 };
+#else
+  uint8_t _prefetchGeneration { 0 };
+#endif // PREFETCH_AVAILABLE
+  uint8_t _prefetchedGeneration { 0 };
+  // Position in ENABLED_ANIMATIONS_LIST of the prefetched and the current
+  // animation, ANIMATION_COUNT for external ones
+  uint8_t _prefetchedId { ANIMATION_COUNT };
+  uint8_t _currentId { ANIMATION_COUNT };
+#ifdef RESUME_AVAILABLE
+  ResumePoint _resume;
+#endif // RESUME_AVAILABLE
+  Transition _transition;
+  Interpolator _interpolator;
+  FrameGovernor _governor;
+  uint8_t _shownRotation { 0 };
+  uint32_t _showUs { 0 };
+  uint8_t _brightness { 0xa0 };
+  OutputStage _output;
+  uint32_t _renderUs { 0 };
+  PowerLimiter _power;
+#ifdef ZONES_AVAILABLE
+  bool _zonesEnabled { false };
+  Zone _zones[Config::ZONE_COUNT];
+#endif // ZONES_AVAILABLE
+
   bool _nextAnimationRequested;
   bool _animationsEnabled;
 #ifdef MOTOR_AVAILABLE
@@ -130,72 +584,62 @@ private:
 ENABLED_ANIMATIONS_LIST
 #undef X
 
-  uint8_t enabledAnimationCount() {
-    uint8_t result = 0;
-
-#define X(field) \
-    if (_enabled##field) result++;
-
-ENABLED_ANIMATIONS_LIST
+#define X(field) Config::DEFAULT_ANIMATION_WEIGHT,
+  uint8_t _weights[ANIMATION_COUNT] = { ENABLED_ANIMATIONS_LIST };
 #undef X
-    return result;
+  bool _weightsChanged { true };
+  Playlist<ANIMATION_COUNT, Config::PLAYLIST_NO_REPEAT, Config::PLAYLIST_MAX_SEQUENCE> _playlist;
+  uint8_t _pendingSequence[Config::PLAYLIST_MAX_SEQUENCE];
+  uint8_t _pendingSequenceLength { 0 };
+  bool _sequenceChanged { false };
+
+  // Creates the next random animation in the spare buffer, unless that already
+  // happened. Without PREFETCH_AVAILABLE only once the current one ended.
+  bool prefetchAnimation() {
+    // A discard during the selection creates it again the next time
+    const uint8_t generation = _prefetchGeneration;
+    if (!_prefetched || _prefetchedGeneration != generation) {
+      _prefetchedGeneration = generation;
+      _prefetchedId = selectAnimation();
+      _prefetched = createAnimation(*_nextBuffer, _prefetchedId);
+    }
+    return _prefetched;
   }
 
-  bool checkEnabled(uint8_t& selected, bool currentState) {
-    if (currentState) {
-      if (selected == 0) {
-        return true;
-      }
-      selected--;
+  // Creates the animation of the checkpoint, which survived a reset, and
+  // overwrites it with the state of the checkpoint
+  bool resumeAnimation(AnimationBuffer& buffer) {
+#ifdef RESUME_AVAILABLE
+    if (_resume.available() && animationSelectable(_resume.animation()) &&
+        createAnimation(buffer, _resume.animation()) && _resume.restore(buffer)) {
+      _prefetchedId = _resume.animation();
+      _brightness = _resume.brightness();
+      Serial.println("Resuming the animation of the checkpoint");
+      return true;
     }
+    _resume.clear();
+#endif // RESUME_AVAILABLE
+    // Without a checkpoint the canvas is undefined after power on
+    allBlack();
     return false;
   }
 
-  bool createAnimation() {
-    uint8_t animationCount = enabledAnimationCount();
-    uint8_t selectedAnimation = random8(animationCount);
-    Serial.print("Selected animation ");
-    Serial.print(selectedAnimation);
-    Serial.print(" of ");
-    Serial.println(animationCount);
-    uint8_t originalSelectedAnimation = selectedAnimation;
-    if (checkEnabled(selectedAnimation, _enabledAlternatingBlink)) {
-      animationBuffer.create<AlternatingBlink>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledGlitterBlink)) {
-      animationBuffer.create<GlitterBlink>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledSnakeAnimation)) {
-      animationBuffer.create<SnakeAnimation>();
-      return true;
+  void saveResumePoint() {
+#ifdef RESUME_AVAILABLE
+    if (_currentId < ANIMATION_COUNT) {
+      _resume.save(_currentId, *_currentBuffer, _brightness);
     }
-    if (checkEnabled(selectedAnimation, _enabledIslandAnimation)) {
-      animationBuffer.create<IslandAnimation>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledMoveAnimation)) {
-      animationBuffer.create<MoveAnimation>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledSprinkleAnimation)) {
-      animationBuffer.create<SprinkleAnimation>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledFallingStacks)) {
-      animationBuffer.create<FallingStacks>();
-      return true;
-    }
-    if (checkEnabled(selectedAnimation, _enabledRotationAnimation)) {
-      RotationAnimation::createRandom(animationBuffer);
-      return true;
-    }
-    Serial.print("Original animation selected was index ");
-    Serial.print(originalSelectedAnimation);
-    Serial.print(" remaining value is ");
-    Serial.println(selectedAnimation);
-    return false;
+#endif // RESUME_AVAILABLE
+  }
+
+  void clearResumePoint() {
+#ifdef RESUME_AVAILABLE
+    _resume.clear();
+#endif // RESUME_AVAILABLE
+  }
+
+  bool createAnimation(AnimationBuffer& buffer) {
+    return createAnimation(buffer, selectAnimation());
   }
 
   publish_animation_t _publishAnimation;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "controller/controller.hpp"
+#include "stackpaint.hpp"
 
 namespace Ferriswheel
 {
@@ -14,6 +15,12 @@ public:
     this->outsideLoop();
   }
 protected:
+  virtual void reportResources() override {
+    Serial.print("Unused stack: ");
+    Serial.print(unusedStackBytes());
+    Serial.println(" bytes");
+  }
+
   virtual void delayFrame() override {
     bool update = false;
     while (!update) {
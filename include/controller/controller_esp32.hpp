@@ -6,27 +6,126 @@
 #include <freertos/task.h>
 #include "controller/controller.hpp"
 #include "config.hpp"
+#include "stream.hpp"
+#include "diagnostics.hpp"
+#include "discovery.hpp"
+#include "preview.hpp"
+#include "slot.hpp"
+#include "sync.hpp"
+#ifdef MOTOR_AVAILABLE
+#include <driver/ledc.h>
+#include "motorprofile.hpp"
+#include "motorphase.hpp"
+#endif // MOTOR_AVAILABLE
 
 namespace Ferriswheel
 {
 
+typedef void (*publish_stream_t)(const PixelStream::Statistics& statistics);
+typedef void (*publish_diagnostics_t)(const Diagnostics::Report& report);
+typedef void (*publish_preview_t)(const uint8_t* data, uint8_t size);
+typedef void (*publish_frame_level_t)(FrameGovernor::Level level);
+typedef void (*publish_power_t)(uint16_t averageMilliamps);
+
 template<uint8_t DATA_PIN>
 class ESP32Controller final : public Controller<DATA_PIN> {
 public:
   void setMqtt(HAMqtt* mqtt) { _mqtt = mqtt; }
 
+  void beginStream() { _stream.begin(); }
+
+  void beginSync() {
+    _sync.begin();
+    _sync.setRole(static_cast<WheelSync::Role>(NVS.getInt(NVS_KEY_SYNC)));
+  }
+  WheelSync::Role syncRole() const { return _sync.role(); }
+  void setSyncRole(WheelSync::Role role) {
+    NVS.setInt(NVS_KEY_SYNC, static_cast<uint8_t>(role));
+    _sync.setRole(role);
+  }
+  void onPublishStream(publish_stream_t handler) { _publishStream = handler; }
+  void onPublishDiagnostics(publish_diagnostics_t handler) { _publishDiagnostics = handler; }
+  void onPublishPreview(publish_preview_t handler) { _publishPreview = handler; }
+  void onPublishFrameLevel(publish_frame_level_t handler) { _publishFrameLevel = handler; }
+  void onPublishPower(publish_power_t handler) { _publishPower = handler; }
+
+  const bool previewEnabled() const { return _preview.enabled(); }
+  void setPreviewEnabled(bool enabled) { _preview.setEnabled(enabled); }
+
+  // A ping message with the time it was sent came back from the MQTT broker
+  void pingReceived(uint32_t sentMs) { _diagnostics.pingReceived(sentMs); }
+
+  // Called early when an animation is resumed, then again after the network connected
   virtual void setupTimer() override {
-    xTaskCreatePinnedToCore(&taskLoop, "Animationloop", 2000, this, 1, nullptr, 1);
+    if (_animationTask) {
+      return;
+    }
+    xTaskCreatePinnedToCore(&taskLoop, "Animationloop", 2000, this, 1, &_animationTask, 1);
 #ifdef MOTOR_AVAILABLE
-    xTaskCreatePinnedToCore(&motorLoop, "Motorloop", 2000, this, 1, nullptr, 1);
+    xTaskCreatePinnedToCore(&motorLoop, "Motorloop", 2000, this, 1, &_motorTask, 1);
 #endif // MOTOR_AVAILABLE
   }
 
   virtual void begin() override {
+    // Different animations after every reset, the AVR boards always start with the same seed
+    seedRandom(esp_random());
     NVS.begin();
+#ifdef AUDIO_AVAILABLE
+    audioInput.begin();
+#endif // AUDIO_AVAILABLE
 
     bool wasEnabled = NVS.getInt(NVS_KEY_ANIMATIONS) > 0;
     Controller<DATA_PIN>::setAnimationsEnabled(wasEnabled);
+
+    uint8_t weights[ANIMATION_COUNT];
+    if (NVS.getBlobSize(NVS_KEY_WEIGHTS) == sizeof(weights) && NVS.getBlob(NVS_KEY_WEIGHTS, weights, sizeof(weights))) {
+      for (uint8_t id = 0; id < ANIMATION_COUNT; id++) {
+        Controller<DATA_PIN>::setAnimationWeight(id, weights[id]);
+      }
+    }
+    uint8_t sequence[Config::PLAYLIST_MAX_SEQUENCE];
+    const size_t sequenceSize = NVS.getBlobSize(NVS_KEY_SEQUENCE);
+    if (sequenceSize > 0 && sequenceSize <= sizeof(sequence) && NVS.getBlob(NVS_KEY_SEQUENCE, sequence, sequenceSize)) {
+      Controller<DATA_PIN>::setSequence(sequence, sequenceSize);
+    }
+
+    uint8_t script[Script::Program::MAX_SIZE];
+    const size_t scriptSize = NVS.getBlobSize(NVS_KEY_SCRIPT);
+    if (scriptSize > 0 && scriptSize <= sizeof(script) && NVS.getBlob(NVS_KEY_SCRIPT, script, scriptSize)) {
+      scriptProgram.upload(script, scriptSize);
+    }
+  }
+
+  // Stores a new script program and restarts the script animation with it
+  bool uploadScript(const uint8_t* code, uint16_t size) {
+    if (!scriptProgram.upload(code, size)) {
+      return false;
+    }
+    NVS.setBlob(NVS_KEY_SCRIPT, const_cast<uint8_t*>(code), size);
+    // The script animation can be selected from now on
+    this->playlistChanged();
+    if (this->isScriptAnimationEnabled()) {
+      this->requestNextAnimation();
+    }
+    return true;
+  }
+
+  virtual void setAnimationWeight(uint8_t id, uint8_t weight) override {
+    Controller<DATA_PIN>::setAnimationWeight(id, weight);
+    uint8_t weights[ANIMATION_COUNT];
+    for (uint8_t i = 0; i < ANIMATION_COUNT; i++) {
+      weights[i] = this->animationWeight(i);
+    }
+    NVS.setBlob(NVS_KEY_WEIGHTS, weights, sizeof(weights));
+  }
+
+  virtual void setSequence(const uint8_t* ids, uint8_t length) override {
+    Controller<DATA_PIN>::setSequence(ids, length);
+    if (length > 0) {
+      NVS.setBlob(NVS_KEY_SEQUENCE, const_cast<uint8_t*>(ids), min(length, Config::PLAYLIST_MAX_SEQUENCE));
+    } else {
+      NVS.erase(NVS_KEY_SEQUENCE);
+    }
   }
 
   virtual void setAnimationsEnabled(bool enabled) override {
@@ -35,99 +134,316 @@ public:
   }
 
   virtual void run() override {
+    _mainTask = xTaskGetCurrentTaskHandle();
     while (true) {
+      _sync.loop();
       if (_mqtt) {
         _mqtt->loop();
+        if (_mqtt->isConnected()) {
+          discoveryCache.connected();
+        }
+      }
+      Diagnostics::Report report;
+      if (_publishDiagnostics && _diagnostics.update(report)) {
+        _publishDiagnostics(report);
+      }
+      uint8_t preview[FramePreview::MAX_SIZE];
+      const uint8_t previewSize = _publishPreview ? _preview.take(preview) : 0;
+      if (previewSize > 0) {
+        _publishPreview(preview, previewSize);
+      }
+      PixelStream::Statistics statistics;
+      if (_publishStream && _streamStatistics.take(statistics)) {
+        _publishStream(statistics);
+      }
+      FrameGovernor::Level level;
+      if (_publishFrameLevel && _frameLevel.take(level)) {
+        _publishFrameLevel(level);
+      }
+      uint16_t averageMilliamps;
+      if (_publishPower && _averageMilliamps.take(averageMilliamps)) {
+        _publishPower(averageMilliamps);
       }
       taskYIELD();
     }
   }
 
 #ifdef MOTOR_AVAILABLE
+  // Keeps the patterns at the same place, while the wheel turns
+  const bool phaseLocked() const { return _phaseLocked; }
+  void setPhaseLocked(bool locked) { _phaseLocked = locked; }
+
+  virtual void setMotorEnabled(bool enabled) override {
+    Controller<DATA_PIN>::setMotorEnabled(enabled);
+    if (_motorTask) {
+      xTaskNotify(_motorTask, MOTOR_SETTINGS_CHANGED, eSetBits);
+    }
+  }
+
+  // Executes the motor profile with hardware fades of the LEDC, so that the
+  // task only wakes up when a segment of the profile ends.
   void innerMotorLoop() {
     vTaskDelay(2000 / portTICK_PERIOD_MS);
 
-    constexpr uint8_t MOTOR_CHANNEL = 1;
-    ledcSetup(MOTOR_CHANNEL, 20000, 8);
+    ledcSetup(MOTOR_CHANNEL, 20000, MOTOR_RESOLUTION_BITS);
     ledcWrite(MOTOR_CHANNEL, 0);
     ledcAttachPin(Config::MOTOR_PIN, MOTOR_CHANNEL);
 
-    constexpr uint8_t speed_step = (Config::MAX_SPEED - Config::MIN_SPEED) / calculateSteps(Config::ACCELERATION_SECONDS * 1000);
-    constexpr uint16_t running_steps = calculateSteps(Config::STOP_EVERY_N_SECONDS * 1000);
-    constexpr uint16_t stopped_steps = calculateSteps(Config::STOP_FOR_N_SECONDS * 1000);
-    uint8_t speed = 0;
-    uint16_t remainingSteps = 0;
-    MotorState state = MotorState::Stopped;
-    while(true) {
-      if (!this->motorEnabled() && state != MotorState::Stopped && state != MotorState::RampDown) {
-        state = MotorState::RampDown;
-      }
-      bool updateSpeed = false;
-      switch (state)
-      {
-      case MotorState::RampDown:
-        if (speed > Config::MIN_SPEED + speed_step) {
-          speed -= speed_step;
-        } else {
-          speed = 0;
-          state = MotorState::Stopped;
-          remainingSteps = stopped_steps;
-        }
-        Serial.println("RampDown");
-        updateSpeed = true;
-        break;
-      case MotorState::RampUp:
-        if (speed < Config::MAX_SPEED - speed_step) {
-          speed += speed_step;
-        } else {
-          speed = Config::MAX_SPEED;
-          state = MotorState::Running;
-          remainingSteps = running_steps;
+    ledc_fade_func_install(0);
+    ledc_cbs_t callbacks = {};
+    callbacks.fade_cb = &motorFadeEnded;
+    ledc_cb_register(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL, &callbacks, xTaskGetCurrentTaskHandle());
+
+    if (Config::MOTOR_INDEX_PIN >= 0) {
+      pinMode(Config::MOTOR_INDEX_PIN, INPUT_PULLUP);
+      attachInterruptArg(Config::MOTOR_INDEX_PIN, &motorIndexPulse, this, FALLING);
+    }
+
+    MotorProfile profile(Config::MOTOR_S_CURVE ? MotorProfile::Shape::SCurve : MotorProfile::Shape::Linear);
+    while (true) {
+      const uint8_t previousDuty = profile.duty();
+      const MotorProfile::Segment segment = profile.next(this->motorEnabled());
+      _motorPhase.segment(esp_timer_get_time(), segment.fade ? previousDuty : segment.duty, segment.duty,
+                          segment.fade ? segment.durationMs : 0);
+      const uint32_t duty = (uint32_t)segment.duty << (MOTOR_RESOLUTION_BITS - 8);
+      if (segment.fade) {
+        Serial.printf("Fading motor to 0x%02x in %u ms\n", segment.duty, (unsigned)segment.durationMs);
+        ledc_set_fade_with_time(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL, duty, segment.durationMs);
+        ledc_fade_start(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL, LEDC_FADE_NO_WAIT);
+        // Changed settings are applied by the next segment
+        while ((waitForMotorEvents(portMAX_DELAY) & MOTOR_FADE_ENDED) == 0) {
         }
-        Serial.println("RampUp");
-        updateSpeed = true;
-        break;
-      }
-      if (updateSpeed) {
-        Serial.printf("New speed 0x%02x\n", speed);
-        ledcWrite(MOTOR_CHANNEL, speed);
       } else {
-        if (remainingSteps == 0) {
-          if (this->motorEnabled()) {
-            if (state == MotorState::Stopped) {
-              state = MotorState::RampUp;
-            } else {
-              state = MotorState::RampDown;
-            }
-          }
-        } else {
-          remainingSteps -= 1;
+        if (ledc_get_duty(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL) != duty) {
+          Serial.printf("New motor speed 0x%02x\n", segment.duty);
+          ledc_set_duty(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL, duty);
+          ledc_update_duty(MOTOR_SPEED_MODE, MOTOR_LEDC_CHANNEL);
         }
+        waitForMotor(profile, segment.durationMs);
       }
-      vTaskDelay(step_time / portTICK_PERIOD_MS);
     }
   }
 #endif // MOTOR_AVAILABLE
 protected:
+#ifdef MOTOR_AVAILABLE
+  virtual uint8_t outputRotation() override {
+    if (!_phaseLocked) {
+      return 0;
+    }
+    const uint32_t phase = _motorPhase.phaseAt(esp_timer_get_time() + SHOW_LATENCY_US);
+    // The LEDs the wheel has moved forward since the start
+    const uint8_t moved = ((uint64_t)phase * NUM_LEDS >> 32) * Config::PHASE_LOCK_TURNS % NUM_LEDS;
+    return Config::MOTOR_TURNS_BACKWARDS ? (NUM_LEDS - moved) % NUM_LEDS : moved;
+  }
+#endif // MOTOR_AVAILABLE
+
+  virtual void frameCompleted(const FrameGovernor& governor, uint32_t showUs, bool dropped) override {
+    _diagnostics.frame(governor, showUs, dropped);
+  }
+
+  virtual void ledsShown(uint8_t rotation) override {
+    _preview.capture(leds, rotation);
+  }
+
+  virtual void frameLevelChanged(FrameGovernor::Level level) override {
+    _frameLevel.put(level);
+  }
+
+  virtual void animationPowerMeasured(uint16_t averageMilliamps) override {
+    _averageMilliamps.put(averageMilliamps);
+  }
+
+  virtual void reportResources() override {
+    // The ESP-IDF reports the unused stack in bytes
+    Serial.printf("Unused stack: main %u, animations %u",
+                  uxTaskGetStackHighWaterMark(_mainTask), uxTaskGetStackHighWaterMark(_animationTask));
+#ifdef MOTOR_AVAILABLE
+    Serial.printf(", motor %u", uxTaskGetStackHighWaterMark(_motorTask));
+#endif // MOTOR_AVAILABLE
+    Serial.println(" bytes");
+#ifdef AUDIO_AVAILABLE
+    Serial.printf("Audio block analyzed in %u us\n", (unsigned)audioInput.processUs());
+#endif // AUDIO_AVAILABLE
+  }
+
   virtual void delayFrame() override {
-    vTaskDelay(10 / portTICK_PERIOD_MS);
+    PixelStream::Statistics statistics;
+    if (_stream.takeStatistics(statistics)) {
+      _streamStatistics.put(statistics);
+    }
+    if (_sync.synchronized()) {
+      // The frames start at the same multiples of the frame time on all wheels
+      const int64_t now = _sync.now();
+      waitForSyncTime(now + FRAME_US - now % FRAME_US);
+    } else {
+      vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+  }
+
+  virtual bool synchronized() override {
+    return _sync.synchronized();
+  }
+
+  virtual bool externalAnimationPending() override {
+    return _stream.pending() || _sync.startPending();
+  }
+
+  virtual bool createExternalAnimation(AnimationBuffer& buffer) override {
+    if (_stream.pending()) {
+      _stream.start();
+      buffer.create<StreamAnimation>(_stream);
+      return true;
+    }
+    switch (_sync.role()) {
+    case WheelSync::Role::Leader:
+      return createLeaderAnimation(buffer);
+    case WheelSync::Role::Follower:
+      return createFollowerAnimation(buffer);
+    default:
+      return false;
+    }
   }
 private:
   static constexpr const char* NVS_KEY_ANIMATIONS = "animations";
+  static constexpr const char* NVS_KEY_SCRIPT = "script";
+  static constexpr const char* NVS_KEY_SYNC = "sync";
+  static constexpr const char* NVS_KEY_WEIGHTS = "weights";
+  static constexpr const char* NVS_KEY_SEQUENCE = "sequence";
+  static constexpr uint16_t FRAME_US = 10000;
 
   HAMqtt* _mqtt;
+  PixelStream _stream;
+  publish_stream_t _publishStream { nullptr };
+  Slot<PixelStream::Statistics> _streamStatistics;
+  Slot<FrameGovernor::Level> _frameLevel;
+  publish_frame_level_t _publishFrameLevel { nullptr };
+  Slot<uint16_t> _averageMilliamps;
+  publish_power_t _publishPower { nullptr };
+  Diagnostics _diagnostics;
+  publish_diagnostics_t _publishDiagnostics { nullptr };
+  FramePreview _preview;
+  publish_preview_t _publishPreview { nullptr };
+  WheelSync _sync;
+
+  TaskHandle_t _mainTask { nullptr };
+  TaskHandle_t _animationTask { nullptr };
+#ifdef MOTOR_AVAILABLE
+  TaskHandle_t _motorTask { nullptr };
+  MotorPhase _motorPhase;
+  bool _phaseLocked { false };
+#endif // MOTOR_AVAILABLE
+
+  void waitForSyncTime(int64_t targetUs) {
+    int64_t remainingUs;
+    while ((remainingUs = targetUs - _sync.now()) > 1000) {
+      vTaskDelay(remainingUs / 1000 / portTICK_PERIOD_MS);
+    }
+    if (remainingUs > 0) {
+      delayMicroseconds(remainingUs);
+    }
+  }
+
+  // The leader picks the next animation and announces it to the followers
+  bool createLeaderAnimation(AnimationBuffer& buffer) {
+    const uint8_t id = this->selectAnimation();
+    if (id >= ANIMATION_COUNT) {
+      return false;
+    }
+    WheelSync::Start start;
+    start.animation = id;
+    start.animationCount = ANIMATION_COUNT;
+    start.seed = esp_random();
+    const int64_t startUs = _sync.now() + Config::SYNC_START_DELAY_MS * 1000;
+    start.startUs = startUs - startUs % FRAME_US;
+    _sync.announce(start);
+    return createSynchronizedAnimation(buffer, start);
+  }
+
+  // A follower shows the animations of the leader, while it is available
+  bool createFollowerAnimation(AnimationBuffer& buffer) {
+    // The leader announces the next animation, when its previous one finished
+    for (uint16_t waitedMs = 0; !_sync.startPending() && _sync.leaderAvailable() &&
+                                waitedMs < Config::SYNC_FOLLOW_WAIT_MS; waitedMs += 10) {
+      vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    WheelSync::Start start;
+    if (!_sync.takeStart(start)) {
+      return false;
+    }
+    if (start.animationCount != ANIMATION_COUNT) {
+      Serial.println("The leader has different animations");
+      return false;
+    }
+    if (start.startUs < _sync.now()) {
+      Serial.println("The start of the leader arrived too late");
+    }
+    return createSynchronizedAnimation(buffer, start);
+  }
+
+  // The animation is created with the seed half a frame before it starts, so
+  // that its first frame is calculated at the start
+  bool createSynchronizedAnimation(AnimationBuffer& buffer, const WheelSync::Start& start) {
+    waitForSyncTime(start.startUs - FRAME_US / 2);
+    seedRandom(start.seed);
+    return this->createAnimation(buffer, start.animation);
+  }
 
 #ifdef MOTOR_AVAILABLE
-  enum class MotorState {
-    Stopped,
-    RampUp,
-    Running,
-    RampDown,
-  };
-
-  static constexpr uint32_t step_time = 100;
-  static constexpr uint32_t calculateSteps(uint32_t milliseconds) {
-    return milliseconds / step_time;
+  // Channel 1 of the Arduino API is channel 1 of the high speed group
+  static constexpr uint8_t MOTOR_CHANNEL = 1;
+  static constexpr ledc_mode_t MOTOR_SPEED_MODE = LEDC_HIGH_SPEED_MODE;
+  static constexpr ledc_channel_t MOTOR_LEDC_CHANNEL = LEDC_CHANNEL_1;
+  // More than the 8 bit of the speeds, so that fades have finer steps
+  static constexpr uint8_t MOTOR_RESOLUTION_BITS = 10;
+
+  // Notification bits of the motor task
+  static constexpr uint32_t MOTOR_FADE_ENDED = 0x01;
+  static constexpr uint32_t MOTOR_SETTINGS_CHANGED = 0x02;
+  static constexpr uint32_t MOTOR_INDEX_PULSE = 0x04;
+  // Time from calculating the rotation until the LEDs are updated
+  static constexpr uint16_t SHOW_LATENCY_US = NUM_LEDS * 30;
+
+  static void IRAM_ATTR motorIndexPulse(void* parameters) {
+    ESP32Controller<DATA_PIN>* controller = static_cast<ESP32Controller<DATA_PIN>*>(parameters);
+    controller->_motorPhase.pulseDetected(esp_timer_get_time());
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(controller->_motorTask, MOTOR_INDEX_PULSE, eSetBits, &woken);
+    if (woken == pdTRUE) {
+      portYIELD_FROM_ISR();
+    }
+  }
+
+  // Waits for the notifications of the motor task and handles index pulses
+  uint32_t waitForMotorEvents(TickType_t timeout) {
+    uint32_t events = 0;
+    xTaskNotifyWait(0, 0xffffffff, &events, timeout);
+    if (events & MOTOR_INDEX_PULSE) {
+      _motorPhase.indexPulse();
+    }
+    return events;
+  }
+
+  static bool IRAM_ATTR motorFadeEnded(const ledc_cb_param_t* parameters, void* task) {
+    BaseType_t woken = pdFALSE;
+    if (parameters->event == LEDC_FADE_END_EVT) {
+      xTaskNotifyFromISR(static_cast<TaskHandle_t>(task), MOTOR_FADE_ENDED, eSetBits, &woken);
+    }
+    return woken == pdTRUE;
+  }
+
+  // Keeps the current duty until the time has passed, or the changed settings
+  // end the segment early.
+  void waitForMotor(const MotorProfile& profile, uint32_t durationMs) {
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t duration = pdMS_TO_TICKS(durationMs);
+    while (durationMs == MotorProfile::FOREVER || xTaskGetTickCount() - start < duration) {
+      const TickType_t remaining = durationMs == MotorProfile::FOREVER
+        ? portMAX_DELAY
+        : duration - (xTaskGetTickCount() - start);
+      if ((waitForMotorEvents(remaining) & MOTOR_SETTINGS_CHANGED) && profile.interrupt(this->motorEnabled())) {
+        return;
+      }
+    }
   }
 
   static void motorLoop(void* parameters) {
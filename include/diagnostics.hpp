@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <freertos/task.h>
+
+#include "config.hpp"
+#include "governor.hpp"
+
+namespace Ferriswheel
+{
+
+// Keeps the last N samples, the oldest one is replaced
+template<typename T, uint8_t N>
+class RollingWindow {
+public:
+  void add(T value) {
+    _values[_next] = value;
+    _next = (_next + 1) % N;
+    if (_count < N) {
+      _count++;
+    }
+  }
+
+  uint8_t count() const { return _count; }
+
+  int32_t sum() const {
+    int32_t result = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      result += _values[i];
+    }
+    return result;
+  }
+
+  T average() const { return _count > 0 ? sum() / _count : 0; }
+
+  T maximum() const {
+    T result = _count > 0 ? _values[0] : 0;
+    for (uint8_t i = 1; i < _count; i++) {
+      result = max(result, _values[i]);
+    }
+    return result;
+  }
+private:
+  T _values[N];
+  uint8_t _next { 0 };
+  uint8_t _count { 0 };
+};
+
+// Collects the health of the controller. The animation task records every
+// frame with a few additions, everything else happens on the main task once a
+// second.
+class Diagnostics {
+public:
+  struct Report {
+    uint32_t freeHeap;
+    uint32_t minimumFreeHeap;
+    // New frames, refreshes of a dithered frame are not counted
+    uint8_t framesPerSecond;
+    // Sums over the last minute
+    uint16_t droppedFrames;
+    uint16_t lateFrames;
+    uint16_t averageShowUs;
+    uint16_t maximumShowUs;
+    int8_t rssi;
+    // 0 when no reply was received
+    uint16_t mqttRoundTripMs;
+  };
+
+  // Called by the animation task after every frame
+  void frame(const FrameGovernor& governor, uint32_t showUs, bool dropped) {
+    portENTER_CRITICAL(&_lock);
+    if (showUs > 0) {
+      _current.shows++;
+      _current.showUs += showUs;
+      _current.maximumShowUs = max(_current.maximumShowUs, showUs);
+    }
+    _current.dropped += dropped;
+    _current.late += governor.late();
+    portEXIT_CRITICAL(&_lock);
+  }
+
+  void pingReceived(uint32_t sentMs) {
+    const uint32_t roundTripMs = millis() - sentMs;
+    _roundTrips.add(roundTripMs < 0xffff ? roundTripMs : 0xffff);
+  }
+
+  // Called by the main task, returns whether a report is due
+  bool update(Report& report) {
+    const uint32_t now = millis();
+    if (now - _lastSampleMs < 1000) {
+      return false;
+    }
+    _lastSampleMs = now;
+
+    portENTER_CRITICAL(&_lock);
+    const Counters counters = _current;
+    _current = Counters();
+    portEXIT_CRITICAL(&_lock);
+
+    _shows.add(min(counters.shows, (uint32_t)0xff));
+    _dropped.add(min(counters.dropped, (uint32_t)0xffff));
+    _late.add(min(counters.late, (uint32_t)0xffff));
+    _averageShowUs.add(counters.shows > 0 ? counters.showUs / counters.shows : 0);
+    _maximumShowUs.add(min(counters.maximumShowUs, (uint32_t)0xffff));
+    _rssi.add(WiFi.RSSI());
+
+    if (++_samples < Config::DIAGNOSTICS_INTERVAL_S) {
+      return false;
+    }
+    _samples = 0;
+    report.freeHeap = ESP.getFreeHeap();
+    report.minimumFreeHeap = ESP.getMinFreeHeap();
+    report.framesPerSecond = _shows.average();
+    report.droppedFrames = _dropped.sum();
+    report.lateFrames = _late.sum();
+    report.averageShowUs = _averageShowUs.average();
+    report.maximumShowUs = _maximumShowUs.maximum();
+    report.rssi = _rssi.average();
+    report.mqttRoundTripMs = _roundTrips.average();
+    return true;
+  }
+private:
+  // Seconds of samples, which are combined in a report
+  static constexpr uint8_t WINDOW = 60;
+
+  struct Counters {
+    uint32_t shows { 0 };
+    uint32_t showUs { 0 };
+    uint32_t maximumShowUs { 0 };
+    uint32_t dropped { 0 };
+    uint32_t late { 0 };
+  };
+
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  Counters _current;
+
+  uint32_t _lastSampleMs { 0 };
+  uint8_t _samples { 0 };
+  RollingWindow<uint8_t, WINDOW> _shows;
+  RollingWindow<uint16_t, WINDOW> _dropped;
+  RollingWindow<uint16_t, WINDOW> _late;
+  RollingWindow<uint16_t, WINDOW> _averageShowUs;
+  RollingWindow<uint16_t, WINDOW> _maximumShowUs;
+  RollingWindow<int8_t, WINDOW> _rssi;
+  RollingWindow<uint16_t, 8> _roundTrips;
+};
+
+};
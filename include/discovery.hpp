@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <ArduinoHA.h>
+
+// The discovery configs are published retained, so the broker still has them
+// after a reset. A hash of the config of every entity, like ArduinoHA would
+// serialize it, is stored in the NVS and while it matches, the configs are not
+// published again on connect.
+class DiscoveryCache {
+public:
+  // Home Assistant entity whose config can be skipped
+  class Entity {
+  public:
+    Entity();
+    virtual void republishConfig() = 0;
+    // Builds the config like for publishing it and adds it to the hash
+    virtual uint32_t hashConfig(uint32_t hash) = 0;
+  private:
+    friend class DiscoveryCache;
+    Entity* _next;
+  };
+
+  // Called after NVS.begin(), when all entities are set up and before the
+  // first connection. The device is part of every config.
+  void begin(const char* uniqueId, const char* name, const char* softwareVersion);
+
+  bool publishRequired() const { return _publishRequired; }
+
+  // Called regularly, while connected. The configs were published during the
+  // connect, so the hash is stored afterwards. The first call prints the time
+  // since the start, the availability was published with the connect.
+  void connected();
+
+  static uint32_t hashSerializer(uint32_t hash, const HASerializer* serializer);
+
+  // Home Assistant lost the configs, for example after it was restarted
+  void republish();
+private:
+  static constexpr const char* NVS_KEY = "discovery";
+
+  static Entity* _first;
+
+  uint32_t _hash { 0 };
+  bool _publishRequired { true };
+  // 0 until the first connect
+  uint32_t _availableMs { 0 };
+};
+
+extern DiscoveryCache discoveryCache;
+
+// Wraps an entity type of ArduinoHA, which builds its config on every connect.
+// When it was published before, no config is built and nothing is published.
+template<class T>
+class Cached final : public T, public DiscoveryCache::Entity {
+public:
+  using T::T;
+
+  virtual void republishConfig() override { this->publishConfig(); }
+
+  virtual uint32_t hashConfig(uint32_t hash) override {
+    T::buildSerializer();
+    hash = DiscoveryCache::hashSerializer(hash, this->_serializer);
+    this->destroySerializer();
+    return hash;
+  }
+protected:
+  virtual void buildSerializer() override {
+    if (discoveryCache.publishRequired()) {
+      T::buildSerializer();
+    }
+  }
+};
+
+#endif // ARDUINO_ARCH_ESP32
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include "config.hpp"
+#include "leds.hpp"
+#include "tables.hpp"
+
+// Positions of the LEDs on the wheel. Angles use 256 units for a full circle
+// (like sin8()) and increase clockwise, 0 being at the top. The lookup tables
+// are generated at compile time and stored in flash.
+namespace geometry {
+
+struct Ring {
+  uint8_t firstLed;
+  uint8_t ledCount;
+  // Angle of the first LED
+  uint8_t startAngle;
+  // Angle from the first LED to the one after the last LED, 256 for a closed
+  // ring. Less leaves a gap, for example at the joint of the strip.
+  uint16_t arc;
+  // Whether the indices increase counterclockwise
+  bool reverse;
+};
+
+// Concentric rings follow each other on the strip
+static constexpr Ring rings[] = {
+  { 0, NUM_LEDS, Config::FIRST_LED_ANGLE, 256, Config::LEDS_COUNTERCLOCKWISE },
+};
+static constexpr uint8_t ringCount = sizeof(rings) / sizeof(rings[0]);
+static_assert(rings[ringCount - 1].firstLed + rings[ringCount - 1].ledCount == NUM_LEDS,
+              "The rings must cover all LEDs");
+
+constexpr uint8_t calculateRing(const uint8_t led, const uint8_t ring = 0) {
+  return ring + 1 >= ringCount || led < rings[ring + 1].firstLed ? ring : calculateRing(led, ring + 1);
+}
+
+constexpr uint8_t calculateAngle(const Ring& ring, const uint8_t led) {
+  return (uint8_t)(ring.startAngle + (ring.reverse ? -1 : 1) * (int16_t)((led - ring.firstLed) * ring.arc / ring.ledCount));
+}
+
+constexpr uint8_t calculateAngle(const uint8_t led) {
+  return calculateAngle(rings[calculateRing(led)], led);
+}
+
+// Index within the ring of the LED closest to the angle relative to the first LED
+constexpr uint8_t calculatePosition(const Ring& ring, const uint8_t relative) {
+  return relative >= ring.arc
+    // Within the gap, the closer end of the ring is used
+    ? (relative - ring.arc < (256 - ring.arc) / 2 ? ring.ledCount - 1 : 0)
+    : ((relative * ring.ledCount + ring.arc / 2) / ring.arc) % ring.ledCount;
+}
+
+constexpr uint8_t calculateLed(const Ring& ring, const uint8_t angle) {
+  return ring.firstLed + calculatePosition(ring, (uint8_t)(ring.reverse ? ring.startAngle - angle : angle - ring.startAngle));
+}
+
+namespace detail {
+
+struct AngleOfLed {
+  typedef uint8_t type;
+  static constexpr uint16_t size = NUM_LEDS;
+  static constexpr uint8_t value(uint16_t led) { return calculateAngle((uint8_t)led); }
+};
+
+// 256 entries for every ring
+struct LedAtAngle {
+  typedef uint8_t type;
+  static constexpr uint16_t size = ringCount * 256;
+  static constexpr uint8_t value(uint16_t index) { return calculateLed(rings[index >> 8], index & 0xff); }
+};
+
+typedef Table<AngleOfLed> Angles;
+typedef Table<LedAtAngle> Leds;
+
+}
+
+inline uint8_t angleOfLed(const uint8_t led) {
+  return pgm_read_byte(&detail::Angles::values[led]);
+}
+
+// The LED of the ring which is closest to the angle
+inline uint8_t ledAtAngle(const uint8_t angle, const uint8_t ring = 0) {
+  return pgm_read_byte(&detail::Leds::values[(uint16_t)ring << 8 | angle]);
+}
+
+inline uint8_t ringOfLed(const uint8_t led) {
+  return calculateRing(led);
+}
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Measures how long calculating and showing a frame takes, compared to the
+// frame tick. When that does not fit, optional work is reduced step by step
+// instead of letting the frames pile up, and restored when there is headroom.
+class FrameGovernor {
+public:
+  enum class Level : uint8_t {
+    Full,
+    // No transitions or interpolated frames
+    NoEffects,
+    // Only every second tick may show a changed frame
+    SkipShows,
+    // Only every fourth tick may show a changed frame
+    QuarterRate,
+  };
+
+  Level level() const { return _level; }
+  // Time the last frame took
+  uint32_t frameUs() const { return _frameUs; }
+  bool late() const { return _frameUs > FRAME_US; }
+  bool effectsAllowed() const { return _level == Level::Full; }
+
+  // Whether a changed frame may be shown on the current tick. Otherwise it is
+  // shown on the next tick, which allows it.
+  bool showAllowed() const {
+    switch (_level) {
+    case Level::SkipShows:
+      return (_tick & 0x01) == 0;
+    case Level::QuarterRate:
+      return (_tick & 0x03) == 0;
+    default:
+      return true;
+    }
+  }
+
+  // Called at the start of the work for the current frame
+  void begin() { _start = micros(); }
+
+  // Called after the current frame was shown, returns whether the level changed
+  bool end() {
+    _tick++;
+    _frameUs = micros() - _start;
+    _elapsedUs += _frameUs;
+    if (++_windowFrames < WINDOW_FRAMES) {
+      return false;
+    }
+
+    const uint32_t budgetUs = (uint32_t)WINDOW_FRAMES * FRAME_US;
+    const uint32_t elapsedUs = _elapsedUs;
+    _elapsedUs = 0;
+    _windowFrames = 0;
+    if (elapsedUs > budgetUs / 10 * OVERLOAD_PERCENT / 10) {
+      _idleWindows = 0;
+      if (_level < Level::QuarterRate) {
+        _level = static_cast<Level>(static_cast<uint8_t>(_level) + 1);
+        return true;
+      }
+    } else if (elapsedUs < budgetUs / 10 * RECOVER_PERCENT / 10 && _level > Level::Full) {
+      // The previous level could need up to twice the time, so wait a bit
+      // longer until the headroom is certain.
+      if (++_idleWindows >= RECOVER_WINDOWS) {
+        _idleWindows = 0;
+        _level = static_cast<Level>(static_cast<uint8_t>(_level) - 1);
+        return true;
+      }
+    } else {
+      _idleWindows = 0;
+    }
+    return false;
+  }
+private:
+  // Matches the 10ms tick of the controllers
+  static constexpr uint16_t FRAME_US = 10000;
+  static constexpr uint8_t WINDOW_FRAMES = 64;
+  static constexpr uint8_t OVERLOAD_PERCENT = 90;
+  static constexpr uint8_t RECOVER_PERCENT = 40;
+  static constexpr uint8_t RECOVER_WINDOWS = 4;
+
+  uint32_t _start { 0 };
+  uint32_t _frameUs { 0 };
+  uint32_t _elapsedUs { 0 };
+  uint8_t _windowFrames { 0 };
+  uint8_t _idleWindows { 0 };
+  uint8_t _tick { 0 };
+  Level _level { Level::Full };
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "animation.hpp"
+#include "config.hpp"
+#include "leds.hpp"
+
+#ifdef INTERPOLATION_AVAILABLE
+
+// Calculates the frames between two steps of an animation, so that slow
+// animations are shown with the full frame rate. The animation draws on a
+// canvas, of which the last two steps are kept.
+class Interpolator {
+public:
+  // Takes the LEDs as the first step of the animation
+  void begin(Animation& animation);
+  // Whether the shown LEDs change on every frame
+  bool active() const { return _mode != Animation::Interpolation::None; }
+  // Calculates the next frame, returns whether the animation made a step
+  bool frame(Animation& animation);
+  // Replaces the interpolated LEDs with the canvas of the animation
+  void end();
+
+  // Disabling it stops the interpolation of the running animation as well
+  void setEnabled(bool enabled) {
+    _enabled = enabled;
+    if (!enabled) {
+      end();
+    }
+  }
+  bool enabled() const { return _enabled; }
+private:
+  alignas(4) CRGB _previous[NUM_LEDS];
+  alignas(4) CRGB _current[NUM_LEDS];
+  Animation::Interpolation _mode { Animation::Interpolation::None };
+  bool _enabled { true };
+
+  void shift(bool down, uint8_t amount);
+};
+
+#else
+
+// Without the RAM for the additional frame buffers, only the steps are shown
+class Interpolator {
+public:
+  void begin(Animation& animation) {}
+  bool active() const { return false; }
+  bool frame(Animation& animation) { return animation.frame(); }
+  void end() {}
+
+  void setEnabled(bool enabled) {}
+  bool enabled() const { return false; }
+};
+
+#endif // INTERPOLATION_AVAILABLE
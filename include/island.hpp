@@ -3,21 +3,25 @@
 #include "animation.hpp"
 #include "leds.hpp"
 
-class IslandAnimation : public FrameAnimation<400> {
+class IslandAnimation : public FrameAnimation {
 public:
-  IslandAnimation() : _color(getRandomColor()) {}
+  IslandAnimation() : FrameAnimation(framesPerMs<400>()), _color(getRandomColor()) {}
 
   virtual bool finished() override;
 
+  virtual Interpolation interpolation() const override {
+    return Interpolation::Blend;
+  }
+
   ANIMATIONNAME("Islands")
 protected:
   virtual void step() override;
 private:
   // TODO: Use divisor-information from stack animation
   static constexpr uint8_t numIslands = 9;
-  static constexpr uint8_t islandWidth = NUM_LEDS / numIslands;
+  static uint8_t islandWidth() { return ledCount() / numIslands; }
 
   CRGB _color;
-  uint8_t _islandIndex { islandWidth / 2 };
+  uint8_t _islandIndex { (uint8_t)(islandWidth() / 2) };
   int8_t _delta { -1 };
 };
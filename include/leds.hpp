@@ -2,6 +2,8 @@
 
 #include <stdint.h>
 #include <FastLED.h>
+#include "config.hpp"
+#include "random.hpp"
 
 bool randomBool();
 
@@ -21,12 +23,43 @@ constexpr uint8_t LED_PIN = 7;
 constexpr uint32_t availableColors[] = {CRGB::Red, CRGB::Yellow, CRGB::Green, CRGB::Ivory};
 constexpr uint8_t availableColorsLength = array_size(availableColors);
 
+// Aligned to 4 bytes, so that frames can be processed a word at a time
 extern CRGB leds[NUM_LEDS];
+#ifdef OUTPUT_STAGE_AVAILABLE
+// The bytes sent to the strip, rendered from leds[] by the OutputStage
+extern CRGB outputLeds[NUM_LEDS];
+#endif
+
+// A part of the strip, like a sector of the wheel
+struct LedSpan {
+  uint8_t offset;
+  uint8_t length;
+};
 
+#ifdef ZONES_AVAILABLE
+// The LEDs the animations draw on. It is the whole strip, except while a zone
+// creates, starts or calculates its animation, then it is the span of the zone.
+extern LedSpan ledView;
+
+inline uint8_t ledCount() { return ledView.length; }
+inline CRGB* firstLed() { return &leds[ledView.offset]; }
+inline void viewWholeStrip() { ledView = { 0, NUM_LEDS }; }
+#else
+constexpr uint8_t ledCount() { return NUM_LEDS; }
+inline CRGB* firstLed() { return leds; }
+#endif // ZONES_AVAILABLE
+
+// Clears the LEDs of the view
 void allBlack();
 
+// Blends two frames, amount 0 returns the first one and 256 the second one.
+// Four channel bytes are processed per operation, the even and odd bytes of a
+// word are scaled in separate 16 bit lanes. All buffers must be 4 byte aligned.
+void blendFrames(const CRGB* from, const CRGB* to, CRGB* output, uint16_t amount);
+
 const CRGB getRandomColor();
 
+// The LED functions count from the start of the view and wrap around at its end
 const uint8_t getLedIndex(int8_t index);
 const uint8_t getLedOffsetIndex(const uint8_t index, const uint8_t offset, const bool reverse = false);
 
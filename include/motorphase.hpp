@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include "config.hpp"
+
+// tools/phase_simulation.cpp runs it against a simulated motor on the host
+#if defined(MOTOR_AVAILABLE) && (defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR))
+
+#include <Arduino.h>
+#include <atomic>
+
+// Estimates the angle of the wheel from the duty cycle of the motor. The motor
+// task starts a new motion for every segment of the motor profile and an index
+// pulse corrects the estimate. Any task can read the angle without locking.
+class MotorPhase {
+public:
+  // A full revolution, the phase wraps around after it
+  static constexpr uint64_t REVOLUTION = 1ULL << 32;
+
+  // The duty changes linearly from fromDuty to toDuty within the duration
+  void segment(int64_t nowUs, uint8_t fromDuty, uint8_t toDuty, uint32_t durationMs);
+  // The index mark passed at the given time, which is defined as phase 0
+  void indexPulse(int64_t pulseUs);
+
+  // Called by the interrupt of the index mark, which may preempt the motor
+  // task. The time has a sequence lock of its own, indexPulse() reads it.
+  void IRAM_ATTR pulseDetected(int64_t pulseUs) {
+    const uint32_t sequence = _pulseSequence.load(std::memory_order_relaxed);
+    _pulseSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _detectedPulseUs = pulseUs;
+    _pulseSequence.store(sequence + 2, std::memory_order_release);
+  }
+  // Called by the motor task after the interrupt, with the detected time
+  void indexPulse();
+
+  uint32_t phaseAt(int64_t timeUs) const;
+private:
+  // Speed of the wheel at MAX_SPEED in phase units per millisecond
+  static constexpr uint32_t MAX_VELOCITY = REVOLUTION / Config::MOTOR_REVOLUTION_MS;
+  // Fixed point with 16 fractional bits
+  static constexpr uint32_t UNITY_GAIN = 0x10000;
+
+  struct Motion {
+    int64_t startUs;
+    uint32_t phase;
+    // Phase units per millisecond at the start and the end of the motion
+    uint32_t startVelocity;
+    uint32_t endVelocity;
+    uint32_t durationUs;
+  };
+
+  // Sequence lock: odd while the motion is written
+  std::atomic<uint32_t> _sequence { 0 };
+  Motion _motion {};
+
+  // Written by the interrupt only
+  std::atomic<uint32_t> _pulseSequence { 0 };
+  int64_t _detectedPulseUs { 0 };
+
+  // Written by the motor task only
+  int64_t _lastPulseUs { -1 };
+  uint32_t _gain { UNITY_GAIN };
+
+  Motion read() const;
+  void write(const Motion& motion);
+  uint32_t velocity(uint8_t duty) const;
+
+  static uint32_t velocityAt(const Motion& motion, int64_t timeUs);
+  static uint32_t phaseAt(const Motion& motion, int64_t timeUs);
+};
+
+#endif // MOTOR_AVAILABLE && (ARDUINO_ARCH_ESP32 || SIMULATOR)
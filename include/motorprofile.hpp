@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include "config.hpp"
+
+#ifdef MOTOR_AVAILABLE
+
+// Plans the speed of the motor as a sequence of segments: accelerate, run for
+// STOP_EVERY_N_SECONDS, decelerate and stay stopped for STOP_FOR_N_SECONDS.
+// It does not access any hardware, the segments are executed by the
+// controller.
+class MotorProfile {
+public:
+  enum class Shape : uint8_t {
+    Linear,
+    // Accelerates slowly at the start and the end of a ramp
+    SCurve,
+  };
+
+  enum class State : uint8_t {
+    Stopped,
+    RampUp,
+    Running,
+    RampDown,
+  };
+
+  struct Segment {
+    // Duty cycle at the end of the segment
+    uint8_t duty;
+    // Duration of the fade, or for how long the duty is kept. FOREVER keeps it
+    // until the settings change.
+    uint32_t durationMs;
+    // Whether the duty changes gradually or immediately
+    bool fade;
+  };
+
+  static constexpr uint32_t FOREVER = 0xffffffff;
+
+  explicit MotorProfile(Shape shape) : _shape(shape) {}
+
+  // Returns the segment after the current one has ended
+  Segment next(bool enabled);
+
+  // Whether the current segment should end early, because the motor was
+  // enabled or disabled. Fades are always completed.
+  bool interrupt(bool enabled) const;
+
+  State state() const { return _state; }
+  uint8_t duty() const { return _duty; }
+private:
+  static constexpr uint32_t RAMP_MS = Config::ACCELERATION_SECONDS * 1000UL;
+  static constexpr uint32_t RUNNING_MS = Config::STOP_EVERY_N_SECONDS * 1000UL;
+  static constexpr uint32_t STOPPED_MS = Config::STOP_FOR_N_SECONDS * 1000UL;
+  // The hardware fades linearly, so the S-curve is approximated with this
+  // many linear segments
+  static constexpr uint8_t SCURVE_SEGMENTS = 4;
+
+  const Shape _shape;
+  State _state { State::Stopped };
+  uint8_t _duty { 0 };
+  uint8_t _rampFrom { 0 };
+  uint8_t _rampSegment { 0 };
+  bool _waiting { false };
+
+  Segment hold(State state, uint8_t duty, uint32_t durationMs);
+  Segment startRamp(State state, uint8_t from);
+  Segment rampSegment(uint8_t to);
+};
+
+#endif // MOTOR_AVAILABLE
@@ -2,10 +2,14 @@
 
 #include "animation.hpp"
 
-class MoveAnimation : public IterationAnimation<NUM_LEDS + 1, 100> {
+class MoveAnimation : public IterationAnimation {
 public:
   MoveAnimation();
 
+  virtual Interpolation interpolation() const override {
+    return _reverse ? Interpolation::ShiftUp : Interpolation::ShiftDown;
+  }
+
   ANIMATIONNAME("Move")
 protected:
   virtual void step() override;
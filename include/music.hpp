@@ -0,0 +1,49 @@
+#pragma once
+
+#include "animation.hpp"
+#include "audio.hpp"
+
+#ifdef AUDIO_AVAILABLE
+
+// Every band of the microphone fills a sector of the wheel like a bar graph
+class BandBarsAnimation : public FrameAnimation {
+public:
+  BandBarsAnimation();
+
+  virtual bool finished() override {
+    return _remainingSteps == 0;
+  }
+
+  ANIMATIONNAME("Band bars")
+protected:
+  virtual void step() override;
+private:
+  // LEDs of the bar of each band
+  static uint8_t sectorLength() { return ledCount() / AudioAnalyzer::BANDS; }
+
+  uint16_t _remainingSteps;
+  // The bars rise immediately, but fall slowly
+  uint8_t _levels[AudioAnalyzer::BANDS] = {};
+};
+
+// Every beat throws a burst of colored sprinkles, which fade until the next
+class BeatSprinkleAnimation : public FrameAnimation {
+public:
+  BeatSprinkleAnimation();
+
+  virtual bool finished() override {
+    return _remainingSteps == 0;
+  }
+
+  virtual void start() override;
+
+  ANIMATIONNAME("Beat sprinkles")
+protected:
+  virtual void step() override;
+private:
+  uint16_t _remainingSteps;
+  uint32_t _beats { 0 };
+  uint8_t _hue;
+};
+
+#endif // AUDIO_AVAILABLE
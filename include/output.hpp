@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "config.hpp"
+
+#ifdef OUTPUT_STAGE_AVAILABLE
+
+// Converts a frame into the bytes sent to the strip in a single pass: every
+// channel is looked up in a gamma table with 16 bit results, scaled by the
+// brightness and the color correction of the channel, and rounded to 8 bits
+// with an ordered dither that changes every frame. Shown repeatedly, the
+// dithered frames average to the 16 bit levels, so dark fades do not band.
+// The frame is rotated on the way and the channels are summed for the current
+// estimate, nothing else has to walk the frame.
+//
+// It does not depend on the Arduino framework, tools/output_benchmark.cpp
+// runs it on the host.
+class OutputStage {
+public:
+  // Sum of every channel of the output bytes
+  struct Sums {
+    uint16_t red;
+    uint16_t green;
+    uint16_t blue;
+  };
+
+  // Brightness as fraction of 0x10000
+  uint16_t scale() const { return _scale; }
+  void setScale(uint16_t scale);
+
+  // Reads count LEDs (three bytes each) starting rotation LEDs into the frame,
+  // the first ones wrap around
+  void render(const uint8_t* frame, uint8_t* output, uint8_t count, uint8_t rotation);
+
+  const Sums& sums() const { return _sums; }
+
+  // Whether the last frame was dithered, then showing it again changes it
+  bool dithering() const { return _dithering; }
+private:
+  uint16_t _scale { 0 };
+  // Brightness multiplied with the color correction
+  uint16_t _channelScales[3] {};
+  uint8_t _frame { 0 };
+  Sums _sums {};
+  bool _dithering { false };
+};
+
+#else
+
+// Without the RAM for the output buffer FastLED scales every pixel of leds[]
+// with the 8 bit brightness and the color correction and dithers it while
+// sending, there is no gamma. Only the channels are summed for the current
+// estimate, like FastLED will send them.
+class OutputStage {
+public:
+  struct Sums {
+    uint16_t red;
+    uint16_t green;
+    uint16_t blue;
+  };
+
+  uint16_t scale() const { return _scale; }
+  void setScale(uint16_t scale);
+
+  // Sums count LEDs (three bytes each) of the frame, which cannot be rotated
+  void measure(const uint8_t* frame, uint8_t count);
+
+  const Sums& sums() const { return _sums; }
+
+  // FastLED changes its dither with every frame it sends, unchanged frames
+  // are not shown again
+  bool dithering() const { return false; }
+private:
+  uint16_t _scale { 0 };
+  uint16_t _channelScales[3] {};
+  Sums _sums {};
+};
+
+#endif // OUTPUT_STAGE_AVAILABLE
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <stdint.h>
+#include "random.hpp"
+
+// Selects the next animation out of N, either in a fixed order or randomly by
+// weight. The random selection uses an alias table, so it takes the same time
+// for every animation: a random column is either taken or replaced by its
+// alias. The table is only rebuilt when the weights changed.
+//
+// The last animations are not selected again, as long as there are others.
+// When the alias table hits a recent one, the draw is repeated by weight over
+// only the others, which keeps their ratios.
+template<uint8_t N, uint8_t NO_REPEAT, uint8_t MAX_SEQUENCE>
+class Playlist {
+  static_assert(N <= 32, "The recent animations are a bitmask");
+public:
+  static constexpr uint8_t NONE = N;
+
+  // Weight 0 excludes an animation
+  void rebuild(const uint8_t (&weights)[N]) {
+    uint16_t total = 0;
+    for (uint8_t id = 0; id < N; id++) {
+      _weights[id] = weights[id];
+      total += weights[id];
+    }
+    _available = total > 0;
+    if (!_available) {
+      return;
+    }
+
+    // Weights scaled so that 256 is the average, the columns with less get
+    // the remainder from one with more as alias
+    uint16_t scaled[N];
+    uint8_t small[N];
+    uint8_t large[N];
+    uint8_t smallCount = 0;
+    uint8_t largeCount = 0;
+    uint16_t assigned = 0;
+    for (uint8_t id = 0; id < N; id++) {
+      scaled[id] = (uint32_t)weights[id] * N * 256 / total;
+      assigned += scaled[id];
+    }
+    // Rounding down leaves a little, which is given to the heaviest
+    uint8_t heaviest = 0;
+    for (uint8_t id = 1; id < N; id++) {
+      if (weights[id] > weights[heaviest]) {
+        heaviest = id;
+      }
+    }
+    scaled[heaviest] += N * 256 - assigned;
+
+    for (uint8_t id = 0; id < N; id++) {
+      if (scaled[id] < 256) {
+        small[smallCount++] = id;
+      } else {
+        large[largeCount++] = id;
+      }
+    }
+    while (smallCount > 0 && largeCount > 0) {
+      const uint8_t less = small[--smallCount];
+      const uint8_t more = large[--largeCount];
+      _probability[less] = scaled[less];
+      _alias[less] = more;
+      scaled[more] -= 256 - scaled[less];
+      if (scaled[more] < 256) {
+        small[smallCount++] = more;
+      } else {
+        large[largeCount++] = more;
+      }
+    }
+    while (largeCount > 0) {
+      const uint8_t id = large[--largeCount];
+      _probability[id] = 256;
+      _alias[id] = id;
+    }
+    while (smallCount > 0) {
+      const uint8_t id = small[--smallCount];
+      _probability[id] = 256;
+      _alias[id] = id;
+    }
+  }
+
+  // An empty sequence returns to the random selection
+  void setSequence(const uint8_t* ids, uint8_t length) {
+    _sequenceLength = 0;
+    for (uint8_t i = 0; i < length && _sequenceLength < MAX_SEQUENCE; i++) {
+      if (ids[i] < N) {
+        _sequence[_sequenceLength++] = ids[i];
+      }
+    }
+    _sequencePosition = 0;
+  }
+
+  uint8_t sequenceLength() const { return _sequenceLength; }
+  const uint8_t* sequence() const { return _sequence; }
+
+  // Returns NONE when no animation has a weight
+  uint8_t next() {
+    if (!_available) {
+      return NONE;
+    }
+    uint8_t id = NONE;
+    // Animations which are excluded now, are skipped in the sequence
+    for (uint8_t i = 0; i < _sequenceLength && id == NONE; i++) {
+      const uint8_t candidate = _sequence[_sequencePosition];
+      _sequencePosition = (_sequencePosition + 1) % _sequenceLength;
+      if (_weights[candidate] > 0) {
+        id = candidate;
+      }
+    }
+
+    if (id == NONE) {
+      id = sample();
+      if (recent(id)) {
+        id = sampleOthers(id);
+      }
+    }
+
+    if (NO_REPEAT > 0) {
+      _recent[_nextRecent] = id;
+      _nextRecent = (_nextRecent + 1) % NO_REPEAT;
+      if (_recentCount < NO_REPEAT) {
+        _recentCount++;
+      }
+      _recentIds = 0;
+      for (uint8_t i = 0; i < _recentCount; i++) {
+        _recentIds |= 1UL << _recent[i];
+      }
+    }
+    return id;
+  }
+private:
+  uint8_t _weights[N] = {};
+  // Chance to keep the column out of 256, otherwise the alias is taken
+  uint16_t _probability[N];
+  uint8_t _alias[N];
+  bool _available { false };
+
+  uint8_t _recent[NO_REPEAT > 0 ? NO_REPEAT : 1];
+  uint8_t _nextRecent { 0 };
+  uint8_t _recentCount { 0 };
+  // Bit per id of _recent
+  uint32_t _recentIds { 0 };
+
+  uint8_t _sequence[MAX_SEQUENCE];
+  uint8_t _sequenceLength { 0 };
+  uint8_t _sequencePosition { 0 };
+
+  uint8_t sample() const {
+    const uint8_t column = randomBelow(N);
+    return randomByte() < _probability[column] ? column : _alias[column];
+  }
+
+  bool recent(uint8_t id) const {
+    return (_recentIds >> id & 1) != 0;
+  }
+
+  // Draws by weight from the animations which are not recent, returns
+  // fallback when only recent ones have a weight
+  uint8_t sampleOthers(uint8_t fallback) const {
+    uint16_t total = 0;
+    for (uint8_t id = 0; id < N; id++) {
+      if (!recent(id)) {
+        total += _weights[id];
+      }
+    }
+    if (total == 0) {
+      return fallback;
+    }
+    uint16_t remaining = randomBelow16(total);
+    for (uint8_t id = 0; id < N; id++) {
+      if (recent(id)) {
+        continue;
+      }
+      if (remaining < _weights[id]) {
+        return id;
+      }
+      remaining -= _weights[id];
+    }
+    return fallback;
+  }
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "config.hpp"
+#include "leds.hpp"
+#include "output.hpp"
+
+// Estimates the current of the strip from the channel sums of the output
+// bytes and lowers the brightness of a frame that would exceed the budget.
+// The output stage sums while it renders, so frames within the budget cost
+// nothing, the others are rendered again.
+class PowerLimiter {
+public:
+  // Returns the scale for the frame, the sums were rendered with scale
+  uint16_t limit(const OutputStage::Sums& sums, uint16_t scale);
+
+  // Estimate of the last frame, with the brightness it is shown with
+  uint16_t milliamps() const { return _milliamps; }
+
+  // Statistics of the frames since the last reset
+  void resetStatistics();
+  uint16_t averageMilliamps() const { return _frames > 0 ? _milliampsSum / _frames : 0; }
+  uint16_t maximumMilliamps() const { return _maximumMilliamps; }
+  // Frames which were dimmed to stay within the budget
+  uint32_t limitedFrames() const { return _limitedFrames; }
+private:
+  uint16_t _milliamps { 0 };
+  uint32_t _milliampsSum { 0 };
+  uint32_t _frames { 0 };
+  uint16_t _maximumMilliamps { 0 };
+  uint32_t _limitedFrames { 0 };
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <FastLED.h>
+#include <freertos/task.h>
+
+#include "config.hpp"
+#include "leds.hpp"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace Ferriswheel
+{
+
+// Low rate preview of the shown frames. The animation task copies a frame
+// into a single slot, which the main task encodes and publishes. While the
+// slot was not taken yet, new frames are skipped instead of queued.
+//
+// The encoded frame starts with the number of buckets, followed by runs of
+// one byte: the length minus one in the upper and the palette index in the
+// lower four bits (see tools/decode_preview.py).
+class FramePreview {
+public:
+  static constexpr uint8_t MAX_SIZE = 1 + Config::PREVIEW_BUCKETS;
+
+  bool enabled() const { return _enabled; }
+  void setEnabled(bool enabled) { _enabled = enabled; }
+
+  // Called by the animation task after a frame was shown, which was moved by
+  // rotation LEDs towards the start
+  void capture(const CRGB* frame, uint8_t rotation) {
+    const uint32_t now = millis();
+    if (!_enabled || now - _lastCaptureMs < Config::PREVIEW_INTERVAL_MS) {
+      return;
+    }
+    _lastCaptureMs = now;
+    portENTER_CRITICAL(&_lock);
+    const bool full = _full;
+    portEXIT_CRITICAL(&_lock);
+    if (full) {
+      return;
+    }
+    memcpy(_snapshot, &frame[rotation], sizeof(CRGB) * (NUM_LEDS - rotation));
+    memcpy(&_snapshot[NUM_LEDS - rotation], frame, sizeof(CRGB) * rotation);
+    portENTER_CRITICAL(&_lock);
+    _full = true;
+    portEXIT_CRITICAL(&_lock);
+  }
+
+  // Called by the main task, returns the size of the encoded frame or 0 when
+  // no frame was captured
+  uint8_t take(uint8_t (&output)[MAX_SIZE]) {
+    portENTER_CRITICAL(&_lock);
+    const bool full = _full;
+    portEXIT_CRITICAL(&_lock);
+    if (!full) {
+      return 0;
+    }
+    const uint8_t size = encode(_snapshot, output);
+    portENTER_CRITICAL(&_lock);
+    _full = false;
+    portEXIT_CRITICAL(&_lock);
+    return size;
+  }
+
+  // Averages the LEDs into the buckets, quantizes them to the palette and
+  // combines equal neighbours into runs
+  static uint8_t encode(const CRGB* frame, uint8_t (&output)[MAX_SIZE]);
+private:
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  bool _full { false };
+  bool _enabled { false };
+  uint32_t _lastCaptureMs { 0 };
+  CRGB _snapshot[NUM_LEDS];
+};
+
+};
+
+#endif // ARDUINO_ARCH_ESP32
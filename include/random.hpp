@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+// Pseudo random numbers for the animations (xorshift32). The sequence only
+// depends on the seed, so the same seed reproduces the same frames.
+void seedRandom(uint32_t seed);
+uint32_t randomState();
+
+uint8_t randomByte();
+uint16_t randomWord();
+
+// Bounded values are exactly uniform. They are scaled from 16 random bits
+// instead of using the remainder. No method is unbiased without ever
+// retrying: here a draw is repeated, and a division needed, only with a
+// chance below limit / 65536.
+uint8_t randomBelow(uint8_t limit);
+uint16_t randomBelow16(uint16_t limit);
+
+inline uint8_t randomBetween(uint8_t minimum, uint8_t limit) {
+  return minimum + randomBelow(limit - minimum);
+}
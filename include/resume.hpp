@@ -0,0 +1,45 @@
+#pragma once
+
+#include "animationbuffer.hpp"
+#include "config.hpp"
+#include "leds.hpp"
+
+#ifdef RESUME_AVAILABLE
+
+// Memory which is not cleared by a reset: RTC slow memory on the ESP32 and
+// the .noinit section on AVR. The AVR boards keep leds[] itself there instead
+// of copying it, as they do not have the RAM for a second canvas.
+#ifdef ARDUINO_ARCH_ESP32
+#define RESUME_NOINIT RTC_NOINIT_ATTR
+#else
+#define RESUME_NOINIT __attribute__((section(".noinit")))
+#define RESUME_KEEPS_LEDS
+#endif
+
+// Checkpoint of the running animation, so that it continues after a watchdog
+// or brownout reset instead of starting over. It holds the animation as raw
+// bytes, the state of the random generator, the brightness and the canvas.
+// A checksum detects a checkpoint that was only partly written or never
+// existed, an identifier of the build (the ELF hash on the ESP32, a sum over
+// the flash on AVR) and the vtable of the animation one of another firmware.
+class ResumePoint {
+public:
+  // Whether there is a valid checkpoint
+  bool available() const;
+
+  // Called after a frame of the animation was shown
+  void save(uint8_t animation, const AnimationBuffer& buffer, uint8_t brightness);
+
+  // Nothing is resumed, when the animations are switched off or external
+  void clear();
+
+  // The animation and brightness of the checkpoint
+  uint8_t animation() const;
+  uint8_t brightness() const;
+
+  // Overwrites a new animation of the same type with the checkpoint and
+  // restores the canvas and the random generator
+  bool restore(AnimationBuffer& buffer);
+};
+
+#endif // RESUME_AVAILABLE
@@ -3,46 +3,33 @@
 #include "animation.hpp"
 #include "animationbuffer.hpp"
 
-class RotationAnimation : public FrameAnimation<50> {
+class RotationAnimation : public FrameAnimation {
 public:
   template<size_t numColors>
   RotationAnimation(const uint32_t (&sectionColors)[numColors],
                     uint8_t sectionMultiply,
-                    const bool isSolid) : _steps(rotationCount * NUM_LEDS) {
-    uint8_t numSections;
+                    const bool isSolid) : FrameAnimation(framesPerMs<50>()), _steps(rotationCount * ledCount()), _numColors(numColors), _isSolid(isSolid) {
+    static_assert(numColors <= maxColors, "Too many colors");
+    memcpy(_colors, sectionColors, sizeof(sectionColors));
     do {
-      numSections = sectionMultiply * numColors;
+      _numSections = sectionMultiply * numColors;
       sectionMultiply--;
-    } while (numSections > NUM_LEDS && sectionMultiply > 0);
-    const uint8_t colorWidth = NUM_LEDS / numSections;
+    } while (_numSections > ledCount() && sectionMultiply > 0);
 
-    const uint8_t colorOffset = random8(numColors);
-
-    uint8_t offset = 0;
-
-    for (int8_t section = numSections - 1; section >= 0; section--) {
-      uint8_t len = colorWidth;
-      if (section == 0) {
-        len = NUM_LEDS - offset;
-      }
-      CRGB color = sectionColors[(colorOffset + section) % numColors];
-      if (isSolid) {
-        fill_solid(&leds[offset], len, color);
-      } else {
-        CRGB sndColor = sectionColors[(colorOffset + section + 1) % numColors];
-        fill_gradient_RGB(&leds[offset], len, sndColor, color);
-      }
-      offset += colorWidth;
-    }
+    _colorOffset = randomBelow(numColors);
+#ifdef PREFETCH_AVAILABLE
+    // The animation is constructed in advance, start() only copies the canvas
+    draw(_canvas);
+#endif
   }
 
   template<size_t numColors>
   RotationAnimation(const uint32_t (&sectionColors)[numColors])
-    : RotationAnimation(sectionColors, random8(3) + 1, randomBool()) {
+    : RotationAnimation(sectionColors, randomBelow(3) + 1, randomBool()) {
   }
 
   static void createRandom(AnimationBuffer& buffer) {
-    switch (random8(3))
+    switch (randomBelow(3))
     {
     case 0:
       {
@@ -70,17 +57,62 @@ public:
     return false;
   }
 
+  virtual void start() override {
+#ifdef PREFETCH_AVAILABLE
+    memcpy(firstLed(), _canvas, sizeof(CRGB) * ledCount());
+#else
+    draw(firstLed());
+#endif
+  }
+
+  virtual Interpolation interpolation() const override {
+    return Interpolation::ShiftDown;
+  }
+
   ANIMATIONNAME("Rotating segments")
 protected:
   virtual void step() override {
     _steps--;
 
-    CRGB temp = _steps < NUM_LEDS ? CRGB::Black : leds[0];
-    memmove(leds, &leds[1], sizeof(CRGB) * (NUM_LEDS - 1));
-    leds[NUM_LEDS - 1] = temp;
+    const uint8_t count = ledCount();
+    CRGB* const strip = firstLed();
+    CRGB temp = _steps < count ? CRGB::Black : strip[0];
+    memmove(strip, &strip[1], sizeof(CRGB) * (count - 1));
+    strip[count - 1] = temp;
   }
 private:
   static constexpr uint8_t rotationCount = 5;
+  static constexpr uint8_t maxColors = 4;
 
   uint16_t _steps;
+  uint32_t _colors[maxColors];
+  uint8_t _numColors;
+  uint8_t _numSections;
+  uint8_t _colorOffset;
+  bool _isSolid;
+#ifdef PREFETCH_AVAILABLE
+  // Only the ledCount() LEDs of the view are drawn
+  CRGB _canvas[NUM_LEDS];
+#endif
+
+  void draw(CRGB* canvas) const {
+    const uint8_t colorWidth = ledCount() / _numSections;
+
+    uint8_t offset = 0;
+
+    for (int8_t section = _numSections - 1; section >= 0; section--) {
+      uint8_t len = colorWidth;
+      if (section == 0) {
+        len = ledCount() - offset;
+      }
+      CRGB color = _colors[(_colorOffset + section) % _numColors];
+      if (_isSolid) {
+        fill_solid(&canvas[offset], len, color);
+      } else {
+        CRGB sndColor = _colors[(_colorOffset + section + 1) % _numColors];
+        fill_gradient_RGB(&canvas[offset], len, sndColor, color);
+      }
+      offset += colorWidth;
+    }
+  }
 };
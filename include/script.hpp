@@ -0,0 +1,114 @@
+#pragma once
+
+#include "animation.hpp"
+
+// Bytecode for user defined animations. A program starts with 'R' 'B' and the
+// version, followed by the instructions. All values on the stack are 32 bit,
+// immediates are little endian and jump targets are offsets from the program
+// start. Stack effects are written as (before -- after).
+namespace Script {
+
+static constexpr uint8_t VERSION = 1;
+static constexpr uint8_t HEADER_SIZE = 3;
+
+enum Opcode : uint8_t {
+  END = 0x00,       // ( -- ) the animation has finished
+  YIELD = 0x01,     // ( ms -- ) show the frame, next step after ms
+  PUSH8 = 0x02,     // ( -- u8 )
+  PUSH16 = 0x03,    // ( -- i16 )
+  PUSH24 = 0x04,    // ( -- u24 ) mostly for colors as 0xRRGGBB
+  DUP = 0x05,       // ( a -- a a )
+  DROP = 0x06,      // ( a -- )
+  SWAP = 0x07,      // ( a b -- b a )
+  OVER = 0x08,      // ( a b -- a b a )
+
+  ADD = 0x10,       // ( a b -- a+b )
+  SUB = 0x11,       // ( a b -- a-b )
+  MUL = 0x12,       // ( a b -- a*b )
+  DIV = 0x13,       // ( a b -- a/b ) 0 when b is 0
+  MOD = 0x14,       // ( a b -- a%b ) 0 when b is 0
+  AND = 0x15,       // ( a b -- a&b )
+  OR = 0x16,        // ( a b -- a|b )
+  XOR = 0x17,       // ( a b -- a^b )
+  SHL = 0x18,       // ( a b -- a<<b )
+  SHR = 0x19,       // ( a b -- a>>b )
+  LT = 0x1a,        // ( a b -- a<b )
+  EQ = 0x1b,        // ( a b -- a==b )
+  NOT = 0x1c,       // ( a -- !a )
+
+  JMP = 0x20,       // u16 target ( -- )
+  JZ = 0x21,        // u16 target ( a -- ) jumps when a is 0
+  JNZ = 0x22,       // u16 target ( a -- ) jumps when a is not 0
+  FOR = 0x23,       // u16 exit ( n -- ) runs the body until NEXT n times
+  NEXT = 0x24,      // ( -- )
+  INDEX = 0x25,     // ( -- i ) counter of the innermost loop
+
+  LOAD = 0x28,      // u8 register ( -- v ) registers keep their value between steps
+  STORE = 0x29,     // u8 register ( v -- )
+  STEP = 0x2a,      // ( -- step ) number of the current step
+  RANDOM = 0x2b,    // ( n -- random number below n )
+  LEDS = 0x2c,      // ( -- count ) LEDs of the strip, or of the zone counted from its first LED
+  ANGLE = 0x2d,     // ( index -- angle ) position on the wheel, 256 per revolution
+  AT_ANGLE = 0x2e,  // ( angle -- index ) LED closest to the angle on the first ring
+
+  SIN8 = 0x30,      // ( theta -- sin8(theta) )
+  SCALE8 = 0x31,    // ( value scale -- scale8(value, scale) )
+  HSV = 0x32,       // ( h s v -- color )
+
+  GET = 0x40,       // ( index -- color )
+  SET = 0x41,       // ( index color -- )
+  FILL = 0x42,      // ( start length color -- ) fill_solid
+  GRADIENT = 0x43,  // ( start length from to -- ) fill_gradient_RGB
+  FADE = 0x44,      // ( amount -- ) fadeToBlackBy on all LEDs
+  ROTATE = 0x45,    // ( n -- ) moves all LEDs by n towards the start
+  BLEND = 0x46,     // ( index color amount -- ) nblend a single LED
+};
+
+// The last uploaded program. Uploads can happen from another task, every
+// ScriptAnimation copies the program when it is constructed and keeps running
+// its copy, even when a newer one arrives meanwhile.
+class Program {
+public:
+  static constexpr uint8_t MAX_SIZE = 192;
+
+  bool upload(const uint8_t* code, uint16_t size);
+
+  // Copies the program and returns its size, 0 when none was uploaded
+  uint8_t copy(uint8_t (&code)[MAX_SIZE]) const;
+
+  bool loaded() const { return _size > 0; }
+private:
+  uint8_t _code[MAX_SIZE];
+  volatile uint8_t _size { 0 };
+};
+
+}
+
+extern Script::Program scriptProgram;
+
+class ScriptAnimation : public DynamicFrameAnimation {
+public:
+  ScriptAnimation();
+
+  virtual bool finished() override {
+    return _finished;
+  }
+
+  ANIMATIONNAME("Script")
+protected:
+  virtual uint16_t step() override;
+private:
+  static constexpr uint8_t STACK_SIZE = 16;
+  static constexpr uint8_t LOOP_DEPTH = 4;
+  static constexpr uint8_t REGISTER_COUNT = 8;
+  // Protection against endless loops within a single step
+  static constexpr uint16_t MAX_INSTRUCTIONS = 8192;
+
+  int32_t _registers[REGISTER_COUNT] = { 0 };
+  uint32_t _steps { 0 };
+  bool _finished { false };
+  uint8_t _size;
+  uint8_t _code[Script::Program::MAX_SIZE];
+
+  uint16_t fail(const char* reason, uint16_t pc);
+};
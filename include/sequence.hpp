@@ -0,0 +1,44 @@
+#pragma once
+
+#include "animation.hpp"
+
+// Pre-rendered frame sequence, played directly from flash.
+//
+// Header (12 bytes, little endian):
+//   'R' 'S' version ledCount frameDelayMs:u16 frameCount:u16 dataSize:u32
+// Each frame is a list of runs, which together cover all LEDs:
+//   00nnnnnn          keep the next n + 1 LEDs of the previous frame
+//   01nnnnnn r g b    fill the next n + 1 LEDs with one color
+//   10nnnnnn rgb...   n + 1 colors follow
+//   11nnnnnn          the frame equals the previous one and is shown n + 1 times as long
+// Keyframes only use fill and literal runs. Sequences are created by
+// tools/encode_sequence.py. In a zone several LEDs of the sequence fall on
+// one LED of the zone, the last one is shown.
+class SequenceAnimation : public DynamicFrameAnimation {
+public:
+  SequenceAnimation(const uint8_t* sequence);
+
+  virtual bool finished() override {
+    return _remainingFrames == 0;
+  }
+
+  // Returns a random sequence from the firmware or the "sequences" partition
+  static const uint8_t* randomSequence();
+
+  ANIMATIONNAME("Sequence")
+protected:
+  virtual uint16_t step() override;
+private:
+  static constexpr uint8_t HEADER_SIZE = 12;
+  static constexpr uint8_t VERSION = 1;
+
+  const uint8_t* _position;
+  uint16_t _frameDelay;
+  uint16_t _remainingFrames;
+
+  static bool isValid(const uint8_t* sequence);
+  static uint32_t totalSize(const uint8_t* sequence);
+
+  uint8_t read();
+  CRGB readColor();
+};
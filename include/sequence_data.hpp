@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Generated by tools/encode_sequence.py
+static const uint8_t cometSequence[] PROGMEM = {
+  0x52, 0x53, 0x01, 0x63, 0x28, 0x00, 0x6a, 0x00, 0xc0, 0x0a, 0x00, 0x00, 0x80, 0xff, 0xc8, 0x78,
+  0x7f, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x81, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f,
+  0x20, 0x82, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1f, 0x83, 0x8c, 0x28,
+  0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1e, 0x84, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1d, 0x85, 0x28,
+  0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8,
+  0x78, 0x3f, 0x1c, 0x86, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00,
+  0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1b, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1a, 0x00, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x19, 0x01, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x18, 0x02, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x17, 0x03, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x16, 0x04, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x15, 0x05, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x14, 0x06, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x13, 0x07, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x12, 0x08, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x11, 0x09, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x10, 0x0a, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x0f, 0x0b, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x0e, 0x0c, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x0d, 0x0d, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x0c, 0x0e, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x0b, 0x0f, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x0a, 0x10, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x09, 0x11, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x08, 0x12, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x07, 0x13, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x06, 0x14, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x05, 0x15, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x04, 0x16, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x03, 0x17, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3f, 0x02, 0x18, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x3f, 0x01, 0x19, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x00, 0x1a, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3f, 0x1b, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x3e, 0x1c, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50,
+  0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3d, 0x1d,
+  0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00,
+  0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3c, 0x1e, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x3b, 0x1f, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x3a,
+  0x20, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28,
+  0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x39, 0x21, 0x87, 0x00, 0x00, 0x00,
+  0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff,
+  0x8c, 0x28, 0xff, 0xc8, 0x78, 0x38, 0x22, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x37, 0x23, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x36, 0x24, 0x87, 0x00, 0x00,
+  0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a,
+  0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x35, 0x25, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28,
+  0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8,
+  0x78, 0x34, 0x26, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x33, 0x27, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x32, 0x28, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00,
+  0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff,
+  0xc8, 0x78, 0x31, 0x29, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10,
+  0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x30, 0x2a, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x2f, 0x2b, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x2e, 0x2c, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50,
+  0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x2d, 0x2d,
+  0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00,
+  0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x2c, 0x2e, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x2b, 0x2f, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x2a,
+  0x30, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28,
+  0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x29, 0x31, 0x87, 0x00, 0x00, 0x00,
+  0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff,
+  0x8c, 0x28, 0xff, 0xc8, 0x78, 0x28, 0x32, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06,
+  0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78,
+  0x27, 0x33, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x26, 0x34, 0x87, 0x00, 0x00,
+  0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a,
+  0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x25, 0x35, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28,
+  0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8,
+  0x78, 0x24, 0x36, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00,
+  0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x23, 0x37, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x22, 0x38, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00,
+  0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff,
+  0xc8, 0x78, 0x21, 0x39, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10,
+  0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x20, 0x3a, 0x87,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8,
+  0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x1f, 0x3b, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x1e, 0x3c, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50,
+  0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x1d, 0x3d,
+  0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00,
+  0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x1c, 0x3e, 0x87, 0x00, 0x00, 0x00, 0x10,
+  0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c,
+  0x28, 0xff, 0xc8, 0x78, 0x1b, 0x3f, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x1a,
+  0x3f, 0x00, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x19, 0x3f, 0x01, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x18, 0x3f, 0x02, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x17, 0x3f, 0x03, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x16,
+  0x3f, 0x04, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x15, 0x3f, 0x05, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x14, 0x3f, 0x06, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x13, 0x3f, 0x07, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x12,
+  0x3f, 0x08, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x11, 0x3f, 0x09, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x10, 0x3f, 0x0a, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x0f, 0x3f, 0x0b, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x0e,
+  0x3f, 0x0c, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x0d, 0x3f, 0x0d, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x0c, 0x3f, 0x0e, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x0b, 0x3f, 0x0f, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x0a,
+  0x3f, 0x10, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x09, 0x3f, 0x11, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x08, 0x3f, 0x12, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x07, 0x3f, 0x13, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x06,
+  0x3f, 0x14, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x05, 0x3f, 0x15, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x04, 0x3f, 0x16, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x03, 0x3f, 0x17, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00,
+  0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x02,
+  0x3f, 0x18, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x01, 0x3f, 0x19, 0x87, 0x00,
+  0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50,
+  0x0a, 0xff, 0x8c, 0x28, 0xff, 0xc8, 0x78, 0x00, 0x3f, 0x1a, 0x87, 0x00, 0x00, 0x00, 0x10, 0x02,
+  0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28,
+  0xff, 0xc8, 0x78, 0x3f, 0x1b, 0x86, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50,
+  0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a, 0xff, 0x8c, 0x28, 0x3f, 0x1c, 0x85, 0x00, 0x00,
+  0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c, 0x28, 0x00, 0xc8, 0x50, 0x0a,
+  0x3f, 0x1d, 0x84, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10, 0x00, 0x8c,
+  0x28, 0x00, 0x3f, 0x1e, 0x83, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x50, 0x10,
+  0x00, 0x3f, 0x1f, 0x82, 0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x28, 0x06, 0x00, 0x3f, 0x20, 0x81,
+  0x00, 0x00, 0x00, 0x10, 0x02, 0x00, 0x3f, 0x21, 0x80, 0x00, 0x00, 0x00,
+};
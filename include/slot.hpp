@@ -0,0 +1,42 @@
+#pragma once
+
+#include <freertos/task.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace Ferriswheel
+{
+
+// Hands a value from the animation task to the main task, which owns the MQTT
+// client. A value which was not taken yet is replaced by the newer one.
+template<class T>
+class Slot {
+public:
+  // Called by the animation task
+  void put(const T& value) {
+    portENTER_CRITICAL(&_lock);
+    _value = value;
+    _full = true;
+    portEXIT_CRITICAL(&_lock);
+  }
+
+  // Called by the main task, returns whether there was a value
+  bool take(T& value) {
+    portENTER_CRITICAL(&_lock);
+    const bool full = _full;
+    if (full) {
+      value = _value;
+      _full = false;
+    }
+    portEXIT_CRITICAL(&_lock);
+    return full;
+  }
+private:
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  T _value;
+  bool _full { false };
+};
+
+};
+
+#endif // ARDUINO_ARCH_ESP32
@@ -4,9 +4,9 @@
 #include "leds.hpp"
 #include "bitset.hpp"
 
-class SnakeAnimation : public FrameAnimation<50> {
+class SnakeAnimation : public FrameAnimation {
 public:
-  SnakeAnimation() : _reverse(randomBool()), _length(startLength), _position(random8(NUM_LEDS)) {}
+  SnakeAnimation() : FrameAnimation(framesPerMs<50>()), _reverse(randomBool()), _length(startLength), _position(randomBelow(ledCount())) {}
 
   virtual bool finished() override {
     return _length == 0;
@@ -18,7 +18,7 @@ protected:
 private:
   static constexpr uint8_t startLength = 3;
   static constexpr uint8_t maxApples = 4;
-  static constexpr uint8_t maxLength = NUM_LEDS / 4 * 3;
+  static uint8_t maxLength() { return ledCount() / 4 * 3; }
   const CRGB head = CRGB::DarkGreen;
   const CRGB oddBody = CRGB::Green;
   const CRGB evenBody = CRGB::Turquoise;
@@ -23,7 +23,7 @@ private:
   bool _brighten;
 };
 
-class SprinkleAnimation : public FrameAnimation<50> {
+class SprinkleAnimation : public FrameAnimation {
 public:
   SprinkleAnimation();
 
@@ -31,13 +31,18 @@ public:
     return _remainingSprinkles == 0;
   }
 
+  virtual Interpolation interpolation() const override {
+    return Interpolation::Blend;
+  }
+
   ANIMATIONNAME("Sprinkle")
 protected:
   virtual void step() override;
 private:
+  // On the whole strip, in a zone only half of its LEDs sparkle at once
   static constexpr uint8_t num_sprinkles = NUM_LEDS / 2;
 
   uint8_t _sprinkles = 0;
-  uint8_t _remainingSprinkles = NUM_LEDS * 2;
+  uint8_t _remainingSprinkles = ledCount() * 2;
   SprinkleState _sprinkleLeds[num_sprinkles];
 };
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifndef ARDUINO_ARCH_ESP32
+
+// The free RAM between the static data and the stack is filled with a pattern
+// on reset. The part which still contains it, was never used by the stack.
+uint16_t unusedStackBytes();
+
+#endif // ARDUINO_ARCH_ESP32
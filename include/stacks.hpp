@@ -6,17 +6,19 @@ class FallingStacks: public DynamicFrameAnimation {
 public:
   FallingStacks()
     : DynamicFrameAnimation(50)
-    , _offset(random8(NUM_LEDS)) {
+    , _offset(randomBelow(ledCount())) {
 
     // in case the for-loop fails (would be a misconfiguration?!)
+    const uint8_t count = ledCount();
     _stackLength = 1;
-    _stackCount = NUM_LEDS;
-    uint8_t index = random8(divisions::numberOfDivisors);
-    for (const divisions::DivisorData& data : divisions::divisorData) {
-      if (data.isDivisor) {
+    _stackCount = count;
+    // The LEDs of a zone have other divisors than the strip
+    uint8_t index = randomBelow(numberOfDivisors(count));
+    for (uint8_t divisor = 1; divisor <= divisions::maximumDivisor; divisor++) {
+      if (isDivisor(count, divisor)) {
         if (index == 0) {
-          _stackLength = data.divisor;
-          _stackCount = data.divident;
+          _stackLength = divisor;
+          _stackCount = count / divisor;
           break;
         }
         index--;
@@ -26,7 +28,7 @@ public:
     // In theory this needs to now test the divisors of _stackLength, but except for primes, it can only be 4, 6, 8, 9
     // or 10. And every number (except 9) has the divisors 1, 2 and half, so this is close enough.
     if (_stackLength % 2 == 0) {
-      switch (random8(3)) {
+      switch (randomBelow(3)) {
         case 0:
         default:
           _fallDistance = 1;
@@ -48,7 +50,7 @@ public:
   }
 
   virtual bool finished() override {
-    return wipe_mode() && _step > CENTER_FAR;
+    return wipe_mode() && _step > centerFar();
   }
 
   ANIMATIONNAME("Stacking")
@@ -75,26 +77,43 @@ private:
   uint8_t _stackCount;
   uint8_t _fallDistance;
 
-  const bool wipe_mode() const { return _stack >= NUM_LEDS; }
+  static bool isDivisor(const uint8_t count, const uint8_t divisor) {
+    return count % divisor == 0 && divisor < count;
+  }
+
+  // Divisors up to the capacity of _stackColors
+  static uint8_t numberOfDivisors(const uint8_t count) {
+    uint8_t divisors = 0;
+    for (uint8_t divisor = 1; divisor <= divisions::maximumDivisor; divisor++) {
+      if (isDivisor(count, divisor)) {
+        divisors++;
+      }
+    }
+    return divisors;
+  }
+
+  const bool wipe_mode() const { return _stack >= ledCount(); }
 
   uint16_t step_fall() {
+    const uint8_t count = ledCount();
+    CRGB* const strip = firstLed();
     for (uint8_t stack_offset = 0; stack_offset < _stackLength; stack_offset++) {
-      uint8_t index = (_step + _offset + stack_offset) % NUM_LEDS;
+      uint8_t index = (_step + _offset + stack_offset) % count;
 
       // Clear previous stack, if this is not the first step
       if (_step > 0 && _stackLength - stack_offset <= _fallDistance) {
         uint8_t oldIndex = index;
         if (oldIndex < _stackLength) {
-          oldIndex += NUM_LEDS;
+          oldIndex += count;
         }
         oldIndex -= _stackLength;
-        leds[oldIndex] = CRGB::Black;
+        strip[oldIndex] = CRGB::Black;
       }
 
-      leds[index] = _stackColors[(_stack + stack_offset) % _stackLength];
+      strip[index] = _stackColors[(_stack + stack_offset) % _stackLength];
     }
     _step += _fallDistance;
-    if (_step > NUM_LEDS - _stack - _stackLength) {
+    if (_step > count - _stack - _stackLength) {
       _step = 0;
       _stack += _stackLength;
       return 700;
@@ -103,12 +122,12 @@ private:
     }
   }
 
-  static constexpr uint8_t CENTER_FAR = NUM_LEDS / 2;
-  static constexpr uint8_t CENTER_NEAR = NUM_LEDS / 2 - (1 - NUM_LEDS % 2);
+  static uint8_t centerFar() { return ledCount() / 2; }
+  static uint8_t centerNear() { return ledCount() / 2 - (1 - ledCount() % 2); }
 
   void step_wipe() {
-    const uint8_t center_far = CENTER_FAR + _step;
-    const uint8_t center_near = CENTER_NEAR - _step;
+    const uint8_t center_far = centerFar() + _step;
+    const uint8_t center_near = centerNear() - _step;
 
     *getLedOffset(center_near, _offset) = CRGB::Black;
     *getLedOffset(center_far, _offset) = CRGB::Black;
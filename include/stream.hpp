@@ -0,0 +1,249 @@
+#pragma once
+
+#include <WiFiUdp.h>
+
+#include "animation.hpp"
+#include "config.hpp"
+#include "leds.hpp"
+
+namespace Ferriswheel
+{
+
+// Receives pixel data via DDP or E1.31 (sACN) and writes the payload directly
+// into leds[]. A frame is complete when a DDP packet has the push flag set or
+// when a packet reaches the end of the strip.
+class PixelStream {
+public:
+  struct Statistics {
+    uint16_t frames;
+    uint32_t droppedPackets;
+    uint32_t averageLatencyUs;
+    uint32_t maximumLatencyUs;
+  };
+
+  void begin() {
+    _ddp.begin(Config::STREAM_DDP_PORT);
+    _e131.beginMulticast(IPAddress(239, 255, Config::STREAM_E131_UNIVERSE >> 8, Config::STREAM_E131_UNIVERSE & 0xff), E131_PORT);
+  }
+
+  // Whether packets arrived while the stream is not shown
+  bool pending() {
+    return !active() && (peek(_ddp, _ddpSize) || peek(_e131, _e131Size));
+  }
+
+  void start() {
+    _active = true;
+    _lastFrameMs = millis();
+    _reportMs = _lastFrameMs;
+  }
+
+  bool active() {
+    if (_active && millis() - _lastFrameMs > Config::STREAM_TIMEOUT_MS) {
+      Serial.println("Stream timed out");
+      _active = false;
+    }
+    return _active;
+  }
+
+  // Decodes all waiting packets until a frame is complete
+  bool receiveFrame() {
+    bool complete = false;
+    while (!complete && peek(_ddp, _ddpSize)) {
+      complete = readDdp();
+      _ddpSize = 0;
+    }
+    while (!complete && peek(_e131, _e131Size)) {
+      complete = readE131();
+      _e131Size = 0;
+    }
+    if (complete) {
+      _lastFrameMs = millis();
+    }
+    return complete;
+  }
+
+  // Called after a complete frame has been sent to the LEDs
+  void shown() {
+    const uint32_t latency = micros() - _frameStartUs;
+    _frameStarted = false;
+    _frames++;
+    _latencySumUs += latency;
+    if (latency > _maximumLatencyUs) {
+      _maximumLatencyUs = latency;
+    }
+  }
+
+  // Returns the statistics of the last second, or false while nothing is due
+  bool takeStatistics(Statistics& statistics) {
+    if (_frames == 0 || millis() - _reportMs < 1000) {
+      return false;
+    }
+    _reportMs = millis();
+    statistics.frames = _frames;
+    statistics.droppedPackets = _droppedPackets;
+    statistics.averageLatencyUs = _latencySumUs / _frames;
+    statistics.maximumLatencyUs = _maximumLatencyUs;
+    _frames = 0;
+    _latencySumUs = 0;
+    _maximumLatencyUs = 0;
+    return true;
+  }
+private:
+  static constexpr uint16_t E131_PORT = 5568;
+  static constexpr uint16_t E131_HEADER_SIZE = 126;
+  // 170 RGB LEDs per universe, like most E1.31 senders assume
+  static constexpr uint16_t E131_CHANNELS_PER_UNIVERSE = 510;
+  static constexpr uint8_t E131_UNIVERSES = (sizeof(leds) + E131_CHANNELS_PER_UNIVERSE - 1) / E131_CHANNELS_PER_UNIVERSE;
+  static constexpr uint8_t E131_OPTION_TERMINATED = 0x40;
+
+  static constexpr uint8_t DDP_HEADER_SIZE = 10;
+  static constexpr uint8_t DDP_TIMECODE_SIZE = 4;
+  static constexpr uint8_t DDP_FLAG_TIMECODE = 0x10;
+  static constexpr uint8_t DDP_FLAG_PUSH = 0x01;
+
+  WiFiUDP _ddp;
+  WiFiUDP _e131;
+  int _ddpSize { 0 };
+  int _e131Size { 0 };
+
+  bool _active { false };
+  uint32_t _lastFrameMs { 0 };
+
+  uint8_t _ddpSequence { 0 };
+  uint8_t _e131Sequence[E131_UNIVERSES];
+  bool _e131SequenceValid[E131_UNIVERSES] = { false };
+
+  bool _frameStarted { false };
+  uint32_t _frameStartUs { 0 };
+  uint32_t _reportMs { 0 };
+  uint16_t _frames { 0 };
+  uint32_t _droppedPackets { 0 };
+  uint32_t _latencySumUs { 0 };
+  uint32_t _maximumLatencyUs { 0 };
+
+  bool peek(WiFiUDP& udp, int& size) {
+    if (size <= 0) {
+      size = udp.parsePacket();
+      if (size > 0 && !_frameStarted) {
+        _frameStarted = true;
+        _frameStartUs = micros();
+      }
+    }
+    return size > 0;
+  }
+
+  // Reads the payload directly into leds[], returns true when it reached the end of the strip
+  bool readPixels(WiFiUDP& udp, uint32_t offset, uint16_t length) {
+    if (offset >= sizeof(leds)) {
+      return false;
+    }
+    if (length > sizeof(leds) - offset) {
+      length = sizeof(leds) - offset;
+    }
+    udp.read(reinterpret_cast<uint8_t*>(leds) + offset, length);
+    return offset + length >= sizeof(leds);
+  }
+
+  bool readDdp() {
+    uint8_t header[DDP_HEADER_SIZE];
+    if (_ddpSize < DDP_HEADER_SIZE || _ddp.read(header, DDP_HEADER_SIZE) != DDP_HEADER_SIZE) {
+      return false;
+    }
+    uint16_t payloadSize = _ddpSize - DDP_HEADER_SIZE;
+    if (header[0] & DDP_FLAG_TIMECODE) {
+      uint8_t timecode[DDP_TIMECODE_SIZE];
+      if (payloadSize < DDP_TIMECODE_SIZE) {
+        return false;
+      }
+      _ddp.read(timecode, DDP_TIMECODE_SIZE);
+      payloadSize -= DDP_TIMECODE_SIZE;
+    }
+
+    // The sequence number counts from 1 to 15, 0 means it is not used
+    const uint8_t sequence = header[1] & 0x0f;
+    if (sequence != 0) {
+      if (_ddpSequence != 0) {
+        const uint8_t expected = _ddpSequence % 15 + 1;
+        _droppedPackets += (sequence + 15 - expected) % 15;
+      }
+      _ddpSequence = sequence;
+    }
+
+    const uint32_t offset = (uint32_t)header[4] << 24 | (uint32_t)header[5] << 16 | (uint32_t)header[6] << 8 | header[7];
+    uint16_t length = header[8] << 8 | header[9];
+    if (length > payloadSize) {
+      length = payloadSize;
+    }
+    const bool reachedEnd = readPixels(_ddp, offset, length);
+    return reachedEnd || (header[0] & DDP_FLAG_PUSH);
+  }
+
+  bool readE131() {
+    static constexpr uint8_t identifier[] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+
+    uint8_t header[E131_HEADER_SIZE];
+    if (_e131Size < E131_HEADER_SIZE || _e131.read(header, E131_HEADER_SIZE) != E131_HEADER_SIZE) {
+      return false;
+    }
+    // Only accept data packets (root vector 4, framing vector 2, DMP vector 2) with DMX start code 0
+    if (memcmp(&header[4], identifier, sizeof(identifier)) != 0 ||
+        header[21] != 0x04 || header[43] != 0x02 || header[117] != 0x02 || header[125] != 0) {
+      return false;
+    }
+    if (header[112] & E131_OPTION_TERMINATED) {
+      Serial.println("Stream terminated");
+      _active = false;
+      return false;
+    }
+
+    const uint16_t universe = header[113] << 8 | header[114];
+    if (universe < Config::STREAM_E131_UNIVERSE || universe - Config::STREAM_E131_UNIVERSE >= E131_UNIVERSES) {
+      return false;
+    }
+    const uint8_t universeIndex = universe - Config::STREAM_E131_UNIVERSE;
+
+    // Discard packets which arrived out of order, otherwise count the gaps
+    const uint8_t sequence = header[111];
+    if (_e131SequenceValid[universeIndex]) {
+      const int8_t difference = sequence - _e131Sequence[universeIndex];
+      if (difference <= 0 && difference > -20) {
+        return false;
+      }
+      // A larger step back is a restarted sender, not a gap
+      if (difference > 1) {
+        _droppedPackets += difference - 1;
+      }
+    }
+    _e131Sequence[universeIndex] = sequence;
+    _e131SequenceValid[universeIndex] = true;
+
+    uint16_t length = (header[123] << 8 | header[124]) - 1;
+    if (length > _e131Size - E131_HEADER_SIZE) {
+      length = _e131Size - E131_HEADER_SIZE;
+    }
+    return readPixels(_e131, (uint32_t)universeIndex * E131_CHANNELS_PER_UNIVERSE, length);
+  }
+};
+
+class StreamAnimation : public Animation {
+public:
+  StreamAnimation(PixelStream& stream) : _stream(stream) {}
+
+  virtual bool finished() override {
+    return !_stream.active();
+  }
+
+  virtual void frameShown() override {
+    _stream.shown();
+  }
+
+  ANIMATIONNAME("External stream")
+protected:
+  virtual bool calculateFrame() override {
+    return _stream.receiveFrame();
+  }
+private:
+  PixelStream& _stream;
+};
+
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include <freertos/task.h>
+
+#include "config.hpp"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR)
+
+namespace Ferriswheel
+{
+
+// Lets several wheels show the same animations. The leader broadcasts which
+// animation starts when and with which random seed, every follower creates it
+// locally with that seed at the same time. The followers measure the offset to
+// the clock of the leader like NTP: the sample with the shortest round trip of
+// the last few requests is used.
+//
+// All packets start with "RW", the version and their type. The numbers are
+// little endian.
+class WheelSync {
+public:
+  enum class Role : uint8_t {
+    Off,
+    Leader,
+    Follower,
+  };
+
+  struct Start {
+    uint8_t animation;
+    // Number of animations, followers with a different list ignore the start
+    uint8_t animationCount;
+    uint32_t seed;
+    // Time of the leader
+    int64_t startUs;
+  };
+
+  void begin();
+
+  Role role() const { return _role; }
+  void setRole(Role role);
+
+  // Called regularly by the main task to answer and send requests
+  void loop();
+
+  // Time of the leader in microseconds
+  int64_t now();
+
+  // Whether the clock of the leader is known
+  bool synchronized();
+
+  // Called by the leader, the start is sent by the main task
+  void announce(const Start& start);
+
+  // Called by the followers, returns whether the leader announced a start
+  bool takeStart(Start& start);
+  bool startPending();
+
+  // A follower got an answer from the leader recently
+  bool leaderAvailable();
+private:
+  static constexpr uint8_t SAMPLES = 8;
+  static constexpr uint16_t REQUEST_INTERVAL_MS = 1000;
+  // Round trips which are longer are not used
+  static constexpr uint32_t MAXIMUM_ROUND_TRIP_US = 100000;
+  static constexpr uint16_t LEADER_TIMEOUT_MS = 5000;
+
+  struct Sample {
+    int64_t offsetUs;
+    uint32_t roundTripUs;
+  };
+
+  WiFiUDP _udp;
+  volatile Role _role { Role::Off };
+
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  int64_t _offsetUs { 0 };
+  bool _offsetKnown { false };
+  uint32_t _lastResponseMs { 0 };
+  Start _start;
+  bool _startReceived { false };
+  // The leader repeats the start until it is due, in case a packet is lost
+  bool _startAnnounced { false };
+  uint32_t _lastAnnounceMs { 0 };
+
+  // Followers take every start only once
+  int64_t _lastStartUs { 0 };
+  Sample _samples[SAMPLES];
+  uint8_t _sampleCount { 0 };
+  uint8_t _nextSample { 0 };
+  uint32_t _lastRequestMs { 0 };
+
+  void receive();
+  void addSample(int64_t requestUs, int64_t leaderUs, int64_t responseUs);
+};
+
+};
+
+#endif // ARDUINO_ARCH_ESP32 || SIMULATOR
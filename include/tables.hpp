@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#ifndef PROGMEM
+// The host tools read the tables like any other array
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#endif
+
+// Lookup tables which are calculated by the compiler and kept in flash. The
+// generator is a struct with the type and size of the table and a constexpr
+// value(index), which is called for every index:
+//
+//   struct Square {
+//     typedef uint16_t type;
+//     static constexpr uint16_t size = 256;
+//     static constexpr uint16_t value(uint16_t index) { return index * index; }
+//   };
+//   pgm_read_word(&Table<Square>::values[7]);
+template<uint16_t... I> struct Indices {};
+template<uint16_t N, uint16_t... I> struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+template<uint16_t... I> struct MakeIndices<0, I...> { typedef Indices<I...> type; };
+
+template<class Generator, class = typename MakeIndices<Generator::size>::type> struct Table;
+template<class Generator, uint16_t... I> struct Table<Generator, Indices<I...>> {
+  static const typename Generator::type values[sizeof...(I)];
+};
+template<class Generator, uint16_t... I>
+const typename Generator::type Table<Generator, Indices<I...>>::values[sizeof...(I)] PROGMEM = { Generator::value(I)... };
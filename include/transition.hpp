@@ -0,0 +1,52 @@
+#pragma once
+
+#include "animation.hpp"
+#include "config.hpp"
+#include "leds.hpp"
+
+#ifdef TRANSITIONS_AVAILABLE
+
+// Shows the new animation in place of the old one over several frames. Both
+// animations keep running, each on its own copy of the LEDs.
+class Transition {
+public:
+  enum class Style : uint8_t {
+    Crossfade,
+    Wipe,
+    Dissolve,
+  };
+
+  void begin(Animation* outgoing);
+  bool active() const { return _outgoing != nullptr; }
+  bool frame(Animation& incoming);
+  void cancel();
+
+  void setEnabled(bool enabled) { _enabled = enabled; }
+private:
+  static constexpr uint8_t FRAMES = Config::TRANSITION_MS / 10;
+
+  alignas(4) CRGB _from[NUM_LEDS];
+  alignas(4) CRGB _to[NUM_LEDS];
+  Animation* _outgoing { nullptr };
+  uint8_t _frame { 0 };
+  Style _style { Style::Crossfade };
+  bool _enabled { true };
+
+  void wipe(uint16_t amount);
+  void dissolve(uint16_t amount);
+};
+
+#else
+
+// Without the RAM for additional frame buffers, animations replace each other
+class Transition {
+public:
+  void begin(Animation* outgoing) {}
+  bool active() const { return false; }
+  bool frame(Animation& incoming) { return false; }
+  void cancel() {}
+
+  void setEnabled(bool enabled) {}
+};
+
+#endif // TRANSITIONS_AVAILABLE
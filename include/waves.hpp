@@ -0,0 +1,80 @@
+#pragma once
+
+#include "animation.hpp"
+#include "leds.hpp"
+
+// The wave animations look up sine, easing and noise in tables, which are
+// calculated by the compiler and kept in flash. Positions are 16 bit phase
+// accumulators that advance by a fixed increment per LED and per step, so no
+// LED needs a multiplication or division to find its place in the wave.
+
+// Two sine waves of different length run around the wheel in opposite
+// directions and blend between two colors. Value noise varies their speed.
+class WavingColors : public FrameAnimation {
+public:
+  WavingColors();
+
+  virtual bool finished() override {
+    return _step >= duration;
+  }
+
+  virtual Interpolation interpolation() const override {
+    return Interpolation::Blend;
+  }
+
+  ANIMATIONNAME("Waving colors")
+protected:
+  virtual void step() override;
+private:
+  static constexpr uint16_t duration = 600;
+  // Steps to fade in at the start and out at the end
+  static constexpr uint8_t fadeSteps = 64;
+
+  CRGB _first;
+  CRGB _second;
+  uint16_t _phases[2] { 0, 0 };
+  // Phase increments from one LED to the next, whole periods fit on the wheel
+  uint16_t _wavelengths[2];
+  int16_t _speeds[2];
+  uint16_t _drift;
+  uint16_t _step { 0 };
+};
+
+// Meteors flash across a dim, twinkling sky, slowing down as they burn out
+class ShootingStars : public FrameAnimation {
+public:
+  ShootingStars();
+
+  virtual bool finished() override {
+    return _remaining == 0 && _fade == 0 && !active();
+  }
+
+  ANIMATIONNAME("Shooting stars")
+protected:
+  virtual void step() override;
+private:
+  static constexpr uint8_t maxStars = 4;
+  static constexpr uint8_t starCount = 24;
+  static constexpr uint8_t tailLength = 8;
+
+  struct Star {
+    uint8_t start;
+    // LEDs from the start to where the star burns out
+    uint8_t distance;
+    // 0 when it appears, 255 when it is gone
+    uint8_t progress;
+    uint8_t speed;
+    bool reverse;
+  };
+
+  Star _stars[maxStars];
+  uint8_t _remaining { starCount };
+  // Brightness of the sky, it fades in at the start and out at the end
+  uint8_t _fade { 0 };
+  uint16_t _time;
+
+  bool active() const;
+  void launch(Star& star);
+  void drawSky();
+  void drawStar(const Star& star);
+};
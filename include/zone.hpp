@@ -0,0 +1,41 @@
+#pragma once
+
+#include "animation.hpp"
+#include "animationbuffer.hpp"
+#include "config.hpp"
+#include "leds.hpp"
+
+#ifdef ZONES_AVAILABLE
+
+// A sector of the wheel with its own animation. While the animation is
+// created, started or calculated, the view of the LEDs is the span of the
+// zone, so it draws its frames directly into its part of leds[]. Between the
+// steps of its animation a zone only counts the frame ticks.
+class Zone {
+public:
+  void begin(const LedSpan& span);
+
+  AnimationBuffer& buffer() { return _buffer; }
+  Animation* animation() { return _running ? _buffer.get() : nullptr; }
+
+  // Counts a frame tick, returns whether the animation needs to calculate it
+  bool advance();
+
+  // Lets the animations draw on the span, until viewWholeStrip()
+  void view() const { ledView = _span; }
+
+  // Clears the span for an animation which was created in the buffer
+  void start();
+  void stop() { _running = false; }
+
+  // Calculates the next frame of the animation, returns whether the span changed
+  bool frame();
+private:
+  AnimationBuffer _buffer;
+  LedSpan _span;
+  // Ticks until the animation steps again
+  uint8_t _idleFrames { 0 };
+  bool _running { false };
+};
+
+#endif // ZONES_AVAILABLE
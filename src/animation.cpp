@@ -0,0 +1,31 @@
+#include "animation.hpp"
+
+bool FrameAnimation::calculateFrame() {
+  if (_frame < _frameDelay) {
+    _frame++;
+    if (_frame == 1) {
+      step();
+      return true;
+    } else {
+      return false;
+    }
+  } else {
+    _frame = 0;
+    return false;
+  }
+}
+
+uint16_t FrameAnimation::stepProgress() const {
+  // A step is done on frame 1, after frame _frameDelay it restarts at 0
+  const uint8_t elapsed = _frame == 0 ? _frameDelay : _frame - 1;
+  return (uint16_t)elapsed * 256 / (_frameDelay + 1);
+}
+
+uint8_t FrameAnimation::idleFrames() const {
+  // The frames up to _frameDelay and the one which restarts at 0
+  return _frame == 0 ? 0 : _frameDelay - _frame + 1;
+}
+
+void FrameAnimation::skipFrames(const uint8_t frames) {
+  _frame = _frame + frames > _frameDelay ? 0 : _frame + frames;
+}
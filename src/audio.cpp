@@ -0,0 +1,69 @@
+#include "audio.hpp"
+
+#ifdef AUDIO_AVAILABLE
+
+#include <driver/i2s.h>
+
+AudioInput audioInput;
+
+void AudioInput::begin() {
+  i2s_config_t config = {};
+  config.mode = static_cast<i2s_mode_t>(I2S_MODE_MASTER | I2S_MODE_RX);
+  config.sample_rate = AudioAnalyzer::SAMPLE_RATE;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_32BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+  config.dma_buf_count = 2;
+  config.dma_buf_len = AudioAnalyzer::SIZE;
+
+  i2s_pin_config_t pins = {};
+  pins.bck_io_num = Config::AUDIO_SCK_PIN;
+  pins.ws_io_num = Config::AUDIO_WS_PIN;
+  pins.data_out_num = I2S_PIN_NO_CHANGE;
+  pins.data_in_num = Config::AUDIO_SD_PIN;
+
+  if (i2s_driver_install(I2S_NUM_0, &config, 0, nullptr) != ESP_OK || i2s_set_pin(I2S_NUM_0, &pins) != ESP_OK) {
+    Serial.println("Microphone not available");
+    return;
+  }
+  xTaskCreatePinnedToCore(&taskLoop, "Audioloop", 3000, this, 1, nullptr, 0);
+}
+
+uint32_t AudioInput::read(uint8_t (&bands)[AudioAnalyzer::BANDS]) {
+  portENTER_CRITICAL(&_lock);
+  memcpy(bands, _bands, sizeof(bands));
+  const uint32_t beats = _beats;
+  portEXIT_CRITICAL(&_lock);
+  return beats;
+}
+
+void AudioInput::taskLoop(void* parameters) {
+  static_cast<AudioInput*>(parameters)->run();
+}
+
+void AudioInput::run() {
+  AudioAnalyzer::Result result;
+  while (true) {
+    size_t size = 0;
+    i2s_read(I2S_NUM_0, _raw, sizeof(_raw), &size, portMAX_DELAY);
+    if (size != sizeof(_raw)) {
+      continue;
+    }
+
+    const uint32_t start = micros();
+    for (uint16_t i = 0; i < AudioAnalyzer::SIZE; i++) {
+      // The 24 bit samples are left aligned, quiet sounds still use a few bits
+      const int32_t sample = _raw[i] >> 14;
+      _samples[i] = sample > 0x7fff ? 0x7fff : sample < -0x7fff ? -0x7fff : sample;
+    }
+    _analyzer.process(_samples, result);
+    _processUs = (_processUs * 15 + (micros() - start)) / 16;
+
+    portENTER_CRITICAL(&_lock);
+    memcpy(_bands, result.bands, sizeof(_bands));
+    _beats += result.beat;
+    portEXIT_CRITICAL(&_lock);
+  }
+}
+
+#endif // AUDIO_AVAILABLE
@@ -0,0 +1,132 @@
+#include "audioanalyzer.hpp"
+
+#include <math.h>
+
+namespace {
+
+// First bin of each band and the end of the last one, about half an octave
+// per band at low and an octave at high frequencies
+const uint8_t bandEdges[AudioAnalyzer::BANDS + 1] = { 1, 2, 4, 7, 12, 20, 34, 58, 128 };
+
+int16_t toQ15(float value) {
+  return (int16_t)lrintf(value * 32767);
+}
+
+// Quiet bands are not scaled up beyond this, per bin of the band
+constexpr uint16_t MIN_PEAK = 16;
+
+uint16_t minimumPeak(uint8_t band) {
+  return (bandEdges[band + 1] - bandEdges[band]) * MIN_PEAK;
+}
+
+// Alpha max plus beta min approximation of the length
+uint16_t magnitude(int16_t real, int16_t imaginary) {
+  const uint16_t a = real < 0 ? -real : real;
+  const uint16_t b = imaginary < 0 ? -imaginary : imaginary;
+  return a > b ? a + b * 3 / 8 : b + a * 3 / 8;
+}
+
+}
+
+AudioAnalyzer::AudioAnalyzer() {
+  for (uint16_t i = 0; i < SIZE / 2; i++) {
+    _window[i] = toQ15(0.5f - 0.5f * cosf(2 * (float)M_PI * i / (SIZE - 1)));
+  }
+  for (uint16_t i = 0; i <= SIZE / 4; i++) {
+    _sine[i] = toQ15(sinf(2 * (float)M_PI * i / SIZE));
+  }
+  for (uint8_t band = 0; band < BANDS; band++) {
+    _peaks[band] = minimumPeak(band);
+  }
+}
+
+int16_t AudioAnalyzer::sine(uint16_t index) const {
+  index &= SIZE - 1;
+  if (index < SIZE / 4) {
+    return _sine[index];
+  } else if (index < SIZE / 2) {
+    return _sine[SIZE / 2 - index];
+  } else if (index < SIZE * 3 / 4) {
+    return -_sine[index - SIZE / 2];
+  }
+  return -_sine[SIZE - index];
+}
+
+void AudioAnalyzer::transform(int16_t* real, int16_t* imaginary) const {
+  // Bit reversed order
+  for (uint16_t i = 1, j = 0; i < SIZE; i++) {
+    uint16_t bit = SIZE >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      int16_t swap = real[i];
+      real[i] = real[j];
+      real[j] = swap;
+      swap = imaginary[i];
+      imaginary[i] = imaginary[j];
+      imaginary[j] = swap;
+    }
+  }
+
+  for (uint16_t length = 2; length <= SIZE; length <<= 1) {
+    const uint16_t half = length / 2;
+    const uint16_t step = SIZE / length;
+    for (uint16_t k = 0; k < half; k++) {
+      const int32_t wr = cosine(k * step);
+      const int32_t wi = -sine(k * step);
+      for (uint16_t a = k; a < SIZE; a += length) {
+        const uint16_t b = a + half;
+        const int32_t tr = (wr * real[b] - wi * imaginary[b]) >> 15;
+        const int32_t ti = (wr * imaginary[b] + wi * real[b]) >> 15;
+        real[b] = (real[a] - tr) >> 1;
+        imaginary[b] = (imaginary[a] - ti) >> 1;
+        real[a] = (real[a] + tr) >> 1;
+        imaginary[a] = (imaginary[a] + ti) >> 1;
+      }
+    }
+  }
+}
+
+void AudioAnalyzer::process(const int16_t* samples, Result& result) {
+  for (uint16_t i = 0; i < SIZE; i++) {
+    const int32_t window = i < SIZE / 2 ? _window[i] : _window[SIZE - 1 - i];
+    _real[i] = (samples[i] * window) >> 15;
+    _imaginary[i] = 0;
+  }
+  transform(_real, _imaginary);
+
+  uint32_t bass = 0;
+  for (uint8_t band = 0; band < BANDS; band++) {
+    uint32_t sum = 0;
+    for (uint8_t bin = bandEdges[band]; bin < bandEdges[band + 1]; bin++) {
+      sum += magnitude(_real[bin], _imaginary[bin]);
+    }
+    const uint16_t value = sum < 0xffff ? sum : 0xffff;
+    if (band < 2) {
+      bass += value;
+    }
+
+    // The peaks decay within a few seconds, which adjusts the gain to the music
+    uint16_t peak = _peaks[band] - _peaks[band] / 64;
+    if (peak < value) {
+      peak = value;
+    }
+    if (peak < minimumPeak(band)) {
+      peak = minimumPeak(band);
+    }
+    _peaks[band] = peak;
+    result.bands[band] = (uint32_t)value * 0xff / peak;
+  }
+
+  // A beat is a bass clearly louder than its average over the last blocks.
+  // The average keeps four fractional bits.
+  result.beat = _beatHold == 0 && bass > minimumPeak(0) + minimumPeak(1) && (bass << 4) > _bassAverage * 3 / 2;
+  if (result.beat) {
+    _beatHold = BEAT_HOLD_BLOCKS;
+  } else if (_beatHold > 0) {
+    _beatHold--;
+  }
+  _bassAverage = _bassAverage - _bassAverage / 16 + bass;
+}
@@ -0,0 +1,114 @@
+#include "discovery.hpp"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <ArduinoNvs.h>
+#include "config.hpp"
+
+namespace {
+
+// FNV-1a
+uint32_t hashString(uint32_t hash, const char* text) {
+  while (*text) {
+    hash ^= (uint8_t)*text++;
+    hash *= 16777619;
+  }
+  // Separates the strings, so that moving characters between them changes the hash
+  hash ^= 0xff;
+  return hash * 16777619;
+}
+
+uint32_t hashByte(uint32_t hash, uint8_t value) {
+  hash ^= value;
+  return hash * 16777619;
+}
+
+}
+
+DiscoveryCache discoveryCache;
+DiscoveryCache::Entity* DiscoveryCache::_first = nullptr;
+
+DiscoveryCache::Entity::Entity() : _next(DiscoveryCache::_first) {
+  DiscoveryCache::_first = this;
+}
+
+void DiscoveryCache::begin(const char* uniqueId, const char* name, const char* softwareVersion) {
+  uint32_t hash = 2166136261;
+  hash = hashString(hash, uniqueId);
+  hash = hashString(hash, name);
+  hash = hashString(hash, softwareVersion);
+  hash = hashString(hash, Config::USE_EXTENDED_UNIQUE_IDS ? "extended" : "");
+  for (Entity* entity = _first; entity != nullptr; entity = entity->_next) {
+    hash = entity->hashConfig(hash);
+  }
+  _hash = hash;
+  _publishRequired = (uint32_t)NVS.getInt(NVS_KEY) != _hash;
+}
+
+// The entries are what ArduinoHA writes the JSON from: the type and name of
+// every property, topic and flag, and the values of the properties
+uint32_t DiscoveryCache::hashSerializer(uint32_t hash, const HASerializer* serializer) {
+  if (serializer == nullptr) {
+    return hash;
+  }
+  const HASerializer::SerializerEntry* entries = serializer->getEntries();
+  for (uint8_t i = 0; i < serializer->getEntriesNb(); i++) {
+    const HASerializer::SerializerEntry& entry = entries[i];
+    hash = hashByte(hash, entry.type);
+    hash = hashByte(hash, entry.subtype);
+    // Flash strings can be read directly on the ESP32
+    if (entry.property != nullptr) {
+      hash = hashString(hash, reinterpret_cast<const char*>(entry.property));
+    }
+    if (entry.type != HASerializer::PropertyEntryType || entry.value == nullptr) {
+      continue;
+    }
+    switch (entry.subtype) {
+    case HASerializer::ConstCharPropertyValue:
+    case HASerializer::ProgmemPropertyValue:
+      hash = hashString(hash, static_cast<const char*>(entry.value));
+      break;
+    case HASerializer::BoolPropertyType:
+      hash = hashByte(hash, *static_cast<const bool*>(entry.value));
+      break;
+    case HASerializer::NumberPropertyType: {
+      char number[24] = {};
+      static_cast<const HANumeric*>(entry.value)->toStr(number);
+      hash = hashString(hash, number);
+      break;
+    }
+    case HASerializer::ArrayPropertyType: {
+      // Options of a select
+      const HASerializerArray* array = static_cast<const HASerializerArray*>(entry.value);
+      char* serialized = new char[array->calculateSize() + 1]();
+      array->serialize(serialized);
+      hash = hashString(hash, serialized);
+      delete[] serialized;
+      break;
+    }
+    }
+  }
+  return hash;
+}
+
+void DiscoveryCache::connected() {
+  if (_availableMs == 0) {
+    _availableMs = millis();
+    Serial.printf("Available %lu ms after the start, %s the discovery configs\n", (unsigned long)_availableMs,
+                  _publishRequired ? "with" : "without");
+  }
+  if (_publishRequired) {
+    NVS.setInt(NVS_KEY, _hash);
+    _publishRequired = false;
+  }
+}
+
+void DiscoveryCache::republish() {
+  _publishRequired = true;
+  for (Entity* entity = _first; entity != nullptr; entity = entity->_next) {
+    entity->republishConfig();
+  }
+  _publishRequired = false;
+}
+
+#endif // ARDUINO_ARCH_ESP32
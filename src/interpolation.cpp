@@ -0,0 +1,54 @@
+#include "interpolation.hpp"
+
+#ifdef INTERPOLATION_AVAILABLE
+
+void Interpolator::begin(Animation& animation) {
+  _mode = _enabled ? animation.interpolation() : Animation::Interpolation::None;
+  memcpy(_previous, leds, sizeof(_previous));
+  memcpy(_current, leds, sizeof(_current));
+}
+
+bool Interpolator::frame(Animation& animation) {
+  if (!active()) {
+    return animation.frame();
+  }
+
+  memcpy(leds, _current, sizeof(_current));
+  const bool stepped = animation.frame();
+  if (stepped) {
+    memcpy(_previous, _current, sizeof(_current));
+    memcpy(_current, leds, sizeof(_current));
+  }
+
+  const uint16_t progress = animation.stepProgress();
+  switch (_mode) {
+  case Animation::Interpolation::None:
+    break;
+  case Animation::Interpolation::Blend:
+    // Lags one step behind, so that it can blend towards the current step
+    blendFrames(_previous, _current, leds, progress);
+    break;
+  case Animation::Interpolation::ShiftDown:
+  case Animation::Interpolation::ShiftUp:
+    // Anticipates the next step, which would move every LED by one
+    shift(_mode == Animation::Interpolation::ShiftDown, min(progress, (uint16_t)0xff));
+    break;
+  }
+  return stepped;
+}
+
+void Interpolator::end() {
+  if (active()) {
+    memcpy(leds, _current, sizeof(_current));
+  }
+  _mode = Animation::Interpolation::None;
+}
+
+void Interpolator::shift(bool down, uint8_t amount) {
+  for (uint8_t led = 0; led < NUM_LEDS; led++) {
+    const uint8_t neighbour = getLedOffsetIndex(led, down ? 1 : NUM_LEDS - 1);
+    leds[led] = blend(_current[led], _current[neighbour], amount);
+  }
+}
+
+#endif // INTERPOLATION_AVAILABLE
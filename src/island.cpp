@@ -6,18 +6,18 @@ bool IslandAnimation::finished() {
   // 5: [0 1 2 3 4]
   //     4 2 1 3 5
 
-  if (islandWidth % 2 == 0) {
+  if (islandWidth() % 2 == 0) {
     return _islandIndex == (uint8_t)-1;
   } else {
-    return _islandIndex == islandWidth;
+    return _islandIndex == islandWidth();
   }
 }
 
 void IslandAnimation::step() {
   uint8_t offset = _islandIndex;
-  while (offset < NUM_LEDS) {
-    leds[offset] = _color;
-    offset += islandWidth;
+  while (offset < ledCount()) {
+    firstLed()[offset] = _color;
+    offset += islandWidth();
   }
 
   _islandIndex += _delta;
@@ -1,56 +1,96 @@
 #include "leds.hpp"
+#include "resume.hpp"
 
-CRGB leds[NUM_LEDS];
+#ifdef RESUME_KEEPS_LEDS
+// Still shows the frame of the checkpoint after a reset
+alignas(4) CRGB leds[NUM_LEDS] RESUME_NOINIT;
+#else
+alignas(4) CRGB leds[NUM_LEDS];
+#endif
+#ifdef OUTPUT_STAGE_AVAILABLE
+CRGB outputLeds[NUM_LEDS];
+#endif
+#ifdef ZONES_AVAILABLE
+LedSpan ledView { 0, NUM_LEDS };
+#endif
 
 bool randomBool() {
-  return (random8() >> 7) == 0;
+  return (randomByte() >> 7) == 0;
 }
 
 void allBlack() {
-  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  fill_solid(firstLed(), ledCount(), CRGB::Black);
 }
 
 const CRGB getRandomColor() {
-  return CRGB(availableColors[random8(availableColorsLength)]);
+  return CRGB(availableColors[randomBelow(availableColorsLength)]);
 }
 
 const uint8_t getLedIndex(int8_t index) {
+  const uint8_t count = ledCount();
   if (index < 0) {
     while (index < 0) {
-      index += NUM_LEDS;
+      index += count;
     }
     return index;
   } else {
-    return index % NUM_LEDS;
+    return index % count;
   }
 }
 
 const uint8_t getLedOffsetIndex(const uint8_t index, const uint8_t offset, const bool reverse) {
+  const uint8_t count = ledCount();
   uint8_t newIndex = index + offset;
   // When this overflowed, the new value will always be lower than either of them
   if (newIndex < index) {
-    // Decrement by NUM_LEDS count until the new value is larger than the
+    // Decrement by the LED count until the new value is larger than the
     // previous sum. In that case it undid the overflow (underflowed).
     uint8_t tempIndex = newIndex;
     while (newIndex <= tempIndex) {
-      newIndex -= NUM_LEDS;
+      newIndex -= count;
     }
   }
-  while (newIndex >= NUM_LEDS) {
-    newIndex -= NUM_LEDS;
+  while (newIndex >= count) {
+    newIndex -= count;
   }
   if (reverse) {
-    newIndex = NUM_LEDS - newIndex - 1;
+    newIndex = count - newIndex - 1;
   }
   return newIndex;
 }
 
 CRGB* getLed(int8_t index) {
   uint8_t absoluteIndex = getLedIndex(index);
-  return &leds[absoluteIndex];
+  return &firstLed()[absoluteIndex];
 }
 
 CRGB* getLedOffset(const uint8_t index, const uint8_t offset, const bool reverse) {
   uint8_t absoluteIndex = getLedOffsetIndex(index, offset, reverse);
-  return &leds[absoluteIndex];
-}
\ No newline at end of file
+  return &firstLed()[absoluteIndex];
+}
+
+void blendFrames(const CRGB* from, const CRGB* to, CRGB* output, uint16_t amount) {
+  constexpr uint32_t LANES = 0x00ff00ff;
+  constexpr uint16_t WORDS = sizeof(CRGB) * NUM_LEDS / sizeof(uint32_t);
+
+  const uint32_t* fromWords = reinterpret_cast<const uint32_t*>(from);
+  const uint32_t* toWords = reinterpret_cast<const uint32_t*>(to);
+  uint32_t* outputWords = reinterpret_cast<uint32_t*>(output);
+  const uint32_t fromScale = 256 - amount;
+  const uint32_t toScale = amount;
+  for (uint16_t i = 0; i < WORDS; i++) {
+    const uint32_t fromWord = fromWords[i];
+    const uint32_t toWord = toWords[i];
+    // Each lane holds at most 255 * 256, so the sum cannot overflow into the next lane
+    const uint32_t even = ((fromWord & LANES) * fromScale + (toWord & LANES) * toScale) >> 8;
+    const uint32_t odd = ((fromWord >> 8 & LANES) * fromScale + (toWord >> 8 & LANES) * toScale) >> 8;
+    outputWords[i] = (even & LANES) | (odd & LANES) << 8;
+  }
+
+  const uint8_t* fromBytes = reinterpret_cast<const uint8_t*>(from);
+  const uint8_t* toBytes = reinterpret_cast<const uint8_t*>(to);
+  uint8_t* outputBytes = reinterpret_cast<uint8_t*>(output);
+  for (uint16_t i = WORDS * sizeof(uint32_t); i < sizeof(CRGB) * NUM_LEDS; i++) {
+    outputBytes[i] = (fromBytes[i] * fromScale + toBytes[i] * toScale) >> 8;
+  }
+}
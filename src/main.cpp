@@ -15,6 +15,7 @@
 #elif ARDUINO_ARCH_ESP32
 #include "secrets.hpp"
 #include "controller/controller_esp32.hpp"
+#include "discovery.hpp"
 #else
 #error "Board is not supported"
 #endif
@@ -30,22 +31,65 @@ Ferriswheel::ESP32Controller<12> controller;
 
 WiFiClient client;
 HADevice device;
+const char* softwareVersion = "1.2.0";
 HAMqtt mqtt(client, device);
 
-HALight animationsSwitch("animations", HALight::BrightnessFeature);
-HAButton nextAnimation("next");
+Cached<HALight> animationsSwitch("animations", HALight::BrightnessFeature);
+Cached<HAButton> nextAnimation("next");
 
 #ifdef MOTOR_AVAILABLE
-HASwitch motorSwitch("motor");
+Cached<HASwitch> motorSwitch("motor");
+Cached<HASwitch> phaseLockSwitch("phase-lock");
 #endif // MOTOR_AVAILABLE
 
-#define X(field) \
-  HASwitch enable##field##Switch("enable-" #field);
+#ifdef ZONES_AVAILABLE
+Cached<HASwitch> zonesSwitch("zones");
+#endif // ZONES_AVAILABLE
+
+#define X(field)                                           \
+  Cached<HASwitch> enable##field##Switch("enable-" #field); \
+  Cached<HANumber> weight##field##Number("weight-" #field); \
+  char weight##field##Name[32];
 
 ENABLED_ANIMATIONS_LIST
 #undef X
 
-HASensor currentAnimation("current-animation");
+// A fixed order of animation names, separated by commas, can be published to
+// riesenrad/<unique id>/playlist. An empty message returns to the random order.
+char playlistTopic[64];
+
+Cached<HASensor> currentAnimation("current-animation");
+
+// Home Assistant publishes "online" here when it starts
+const char* statusTopic = "homeassistant/status";
+
+// Script programs for ScriptAnimation are published (binary) to riesenrad/<unique id>/script
+char scriptTopic[64];
+Cached<HASensorNumber> streamLatency("stream-latency", HASensorNumber::PrecisionP1);
+Cached<HASensorNumber> streamDropped("stream-dropped");
+// 0 while the frames fit into their budget, higher values reduce the quality more
+Cached<HASensorNumber> frameLevel("frame-level");
+// Average of the last animation
+Cached<HASensorNumber> estimatedCurrent("estimated-current");
+
+// Diagnostics, the MQTT round trip is measured with messages to riesenrad/<unique id>/ping.
+// ArduinoHA 2.1 cannot set the entity category, so they are regular sensors.
+char pingTopic[64];
+Cached<HASensorNumber> freeHeap("free-heap");
+Cached<HASensorNumber> minimumFreeHeap("minimum-free-heap");
+Cached<HASensorNumber> framesPerSecond("frames-per-second");
+Cached<HASensorNumber> droppedFrames("dropped-frames");
+Cached<HASensorNumber> lateFrames("late-frames");
+Cached<HASensorNumber> showTime("show-time");
+Cached<HASensorNumber> maximumShowTime("maximum-show-time");
+Cached<HASensorNumber> wifiSignal("wifi-signal");
+Cached<HASensorNumber> mqttRoundTrip("mqtt-round-trip");
+
+// Encoded frames (see preview.hpp) are published to riesenrad/<unique id>/preview
+char previewTopic[64];
+Cached<HASwitch> previewSwitch("preview");
+// Order of WheelSync::Role
+Cached<HASelect> syncSelect("sync");
 #endif
 
 #ifdef TIMER_VEC
@@ -67,8 +111,37 @@ void onSwitchCommand(bool state, HASwitch* sender)
   controller.setMotorEnabled(state);
   sender->setState(state);
 }
+
+void onPhaseLockCommand(bool state, HASwitch* sender)
+{
+  controller.setPhaseLocked(state);
+  sender->setState(state);
+}
 #endif // MOTOR_AVAILABLE
 
+#ifdef ZONES_AVAILABLE
+void onZonesCommand(bool state, HASwitch* sender)
+{
+  controller.setZonesEnabled(state);
+  sender->setState(state);
+}
+#endif // ZONES_AVAILABLE
+
+void onPreviewCommand(bool state, HASwitch* sender)
+{
+  controller.setPreviewEnabled(state);
+  sender->setState(state);
+}
+
+void onSyncCommand(int8_t index, HASelect* sender)
+{
+  if (index < 0 || index > static_cast<int8_t>(Ferriswheel::WheelSync::Role::Follower)) {
+    return;
+  }
+  controller.setSyncRole(static_cast<Ferriswheel::WheelSync::Role>(index));
+  sender->setState(index);
+}
+
 void onAnimationStateCommand(bool state, HASwitch* sender)
 {
 #define X(field)                                       \
@@ -83,10 +156,47 @@ ENABLED_ANIMATIONS_LIST
   Serial.println("Unknown animation switch!");
 }
 
+void onWeightCommand(HANumeric number, HANumber* sender)
+{
+#define X(field)                                                             \
+  if (sender == &weight##field##Number) {                                    \
+    controller.setAnimationWeight(Ferriswheel::field##Id, number.toUInt8()); \
+    sender->setState(controller.animationWeight(Ferriswheel::field##Id));    \
+    return;                                                                  \
+  }
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+}
+
+void receivePlaylist(const uint8_t* payload, uint16_t length) {
+  char names[256];
+  const uint16_t size = min(length, (uint16_t)(sizeof(names) - 1));
+  memcpy(names, payload, size);
+  names[size] = '\0';
+
+  uint8_t ids[Config::PLAYLIST_MAX_SEQUENCE];
+  uint8_t count = 0;
+  for (char* name = strtok(names, ","); name != nullptr && count < sizeof(ids); name = strtok(nullptr, ",")) {
+    while (*name == ' ') {
+      name++;
+    }
+#define X(field)                           \
+    if (strcmp(name, field::NAME) == 0) {  \
+      ids[count++] = Ferriswheel::field##Id; \
+      continue;                            \
+    }
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+    Serial.printf("Unknown animation in playlist: %s\n", name);
+  }
+  controller.setSequence(ids, count);
+  Serial.printf("Playlist with %u animations received\n", count);
+}
+
 void onBrightnessCommand(uint8_t brightness, HALight* sender) {
-  brightness = map(brightness, 0, 0xff, 0, Config::MAX_BRIGHTNESS);
-  FastLED.setBrightness(brightness);
-  brightness = map(brightness, 0, Config::MAX_BRIGHTNESS, 0, 0xff);
+  controller.setBrightness(brightness);
   sender->setBrightness(brightness);
 }
 
@@ -104,6 +214,77 @@ void publishAnimation(const Animation* animation) {
     currentAnimation.setValue(name);
   }
 }
+
+void onMqttConnected() {
+  mqtt.subscribe(scriptTopic);
+  mqtt.subscribe(pingTopic);
+  mqtt.subscribe(statusTopic);
+  mqtt.subscribe(playlistTopic);
+}
+
+void onMqttMessage(const char* topic, const uint8_t* payload, uint16_t length) {
+  if (strcmp(topic, scriptTopic) == 0) {
+    if (controller.uploadScript(payload, length)) {
+      Serial.printf("Received script with %u bytes\n", length);
+    } else {
+      Serial.println("Invalid script received");
+    }
+  } else if (strcmp(topic, pingTopic) == 0) {
+    char sent[12];
+    const uint16_t size = min(length, (uint16_t)(sizeof(sent) - 1));
+    memcpy(sent, payload, size);
+    sent[size] = '\0';
+    controller.pingReceived(strtoul(sent, nullptr, 10));
+  } else if (strcmp(topic, playlistTopic) == 0) {
+    receivePlaylist(payload, length);
+  } else if (strcmp(topic, statusTopic) == 0) {
+    // Sent when Home Assistant starts, it may have lost the retained configs
+    if (length == 6 && memcmp(payload, "online", 6) == 0) {
+      discoveryCache.republish();
+    }
+  }
+}
+
+void publishFrameLevel(FrameGovernor::Level level) {
+  frameLevel.setValue(static_cast<uint8_t>(level));
+}
+
+void publishPower(uint16_t averageMilliamps) {
+  estimatedCurrent.setValue(averageMilliamps);
+}
+
+void publishDiagnostics(const Ferriswheel::Diagnostics::Report& report) {
+  freeHeap.setValue(report.freeHeap);
+  minimumFreeHeap.setValue(report.minimumFreeHeap);
+  framesPerSecond.setValue(report.framesPerSecond);
+  droppedFrames.setValue(report.droppedFrames);
+  lateFrames.setValue(report.lateFrames);
+  showTime.setValue(report.averageShowUs);
+  maximumShowTime.setValue(report.maximumShowUs);
+  wifiSignal.setValue(report.rssi);
+  mqttRoundTrip.setValue(report.mqttRoundTripMs);
+
+  // The reply is measured with the next report
+  char sent[12];
+  snprintf(sent, sizeof(sent), "%lu", (unsigned long)millis());
+  mqtt.publish(pingTopic, sent);
+}
+
+void publishPreview(const uint8_t* data, uint8_t size) {
+  // Frames, which are captured while this blocks, are skipped
+  if (mqtt.beginPublish(previewTopic, size, false)) {
+    mqtt.writePayload(data, size);
+    mqtt.endPublish();
+  }
+}
+
+void publishStream(const Ferriswheel::PixelStream::Statistics& statistics) {
+  streamLatency.setValue(statistics.averageLatencyUs / 1000.0f);
+  streamDropped.setValue(statistics.droppedPackets);
+  Serial.printf("Stream: %u frames, latency avg %u us max %u us, %u dropped packets\n",
+                statistics.frames, (unsigned)statistics.averageLatencyUs, (unsigned)statistics.maximumLatencyUs,
+                (unsigned)statistics.droppedPackets);
+}
 #endif
 
 void setup() {
@@ -114,12 +295,25 @@ void setup() {
 
   Serial.begin(57600);
 
-  FastLED.addLeds<WS2812B, controller.rgbLEDpin(), GRB>(leds, NUM_LEDS);
-  FastLED.setBrightness(30);
+#ifdef OUTPUT_STAGE_AVAILABLE
+  // Gamma, brightness and dithering are applied by the controller's output stage
+  FastLED.addLeds<WS2812B, controller.rgbLEDpin(), GRB>(outputLeds, NUM_LEDS);
+  FastLED.setDither(DISABLE_DITHER);
+#else
+  // The brightness is set by the controller, FastLED applies it while sending
+  FastLED.addLeds<WS2812B, controller.rgbLEDpin(), GRB>(leds, NUM_LEDS).setCorrection(CRGB(Config::COLOR_CORRECTION));
+  FastLED.setDither(Config::TEMPORAL_DITHERING ? BINARY_DITHER : DISABLE_DITHER);
+#endif // OUTPUT_STAGE_AVAILABLE
+  controller.setBrightness(0xa0);
 
   controller.begin();
 
   #ifdef ARDUINO_ARCH_ESP32
+  // An animation interrupted by a reset continues while the network connects
+  if (controller.resumable()) {
+    controller.setupTimer();
+  }
+
   // Unique ID must be set!
   byte mac[6] = {0};
   WiFi.macAddress(mac);
@@ -144,7 +338,7 @@ void setup() {
 
   // set device's details (optional)
   device.setName(Config::NAME);
-  device.setSoftwareVersion("1.2.0");
+  device.setSoftwareVersion(softwareVersion);
 
   // handle switch state
   animationsSwitch.onStateCommand(onStateCommand);
@@ -154,11 +348,26 @@ void setup() {
 #ifdef MOTOR_AVAILABLE
   motorSwitch.onCommand(onSwitchCommand);
   motorSwitch.setName("Motor");
+  phaseLockSwitch.onCommand(onPhaseLockCommand);
+  phaseLockSwitch.setName("Stationary patterns");
+  phaseLockSwitch.setIcon("mdi:ferris-wheel");
 #endif // MOTOR_AVAILABLE
 
-#define X(field) \
-  enable##field##Switch.setName(field::NAME); \
-  enable##field##Switch.onCommand(onAnimationStateCommand);
+#ifdef ZONES_AVAILABLE
+  zonesSwitch.onCommand(onZonesCommand);
+  zonesSwitch.setName("Zones");
+  zonesSwitch.setIcon("mdi:chart-pie");
+#endif // ZONES_AVAILABLE
+
+#define X(field)                                                                      \
+  enable##field##Switch.setName(field::NAME);                                          \
+  enable##field##Switch.onCommand(onAnimationStateCommand);                            \
+  snprintf(weight##field##Name, sizeof(weight##field##Name), "%s weight", field::NAME); \
+  weight##field##Number.setName(weight##field##Name);                                  \
+  weight##field##Number.setIcon("mdi:weight");                                         \
+  weight##field##Number.setMin(0);                                                     \
+  weight##field##Number.setMax(100);                                                   \
+  weight##field##Number.onCommand(onWeightCommand);
 
 ENABLED_ANIMATIONS_LIST
 #undef X
@@ -170,21 +379,91 @@ ENABLED_ANIMATIONS_LIST
   currentAnimation.setName("Current");
   currentAnimation.setIcon("mdi:animation");
 
-  mqtt.begin(Config::Secrets::BROKER_ADDR, Config::Secrets::MQTT_USER, Config::Secrets::MQTT_PASSWORD);
+  streamLatency.setName("Stream latency");
+  streamLatency.setIcon("mdi:timer-outline");
+  streamLatency.setUnitOfMeasurement("ms");
+  streamDropped.setName("Stream dropped packets");
+  streamDropped.setIcon("mdi:package-variant-remove");
+  frameLevel.setName("Frame budget level");
+  frameLevel.setIcon("mdi:speedometer-slow");
+  estimatedCurrent.setName("Estimated current");
+  estimatedCurrent.setDeviceClass("current");
+  estimatedCurrent.setUnitOfMeasurement("mA");
+
+  freeHeap.setName("Free heap");
+  freeHeap.setIcon("mdi:memory");
+  freeHeap.setUnitOfMeasurement("B");
+  minimumFreeHeap.setName("Minimum free heap");
+  minimumFreeHeap.setIcon("mdi:memory");
+  minimumFreeHeap.setUnitOfMeasurement("B");
+  framesPerSecond.setName("Frame rate");
+  framesPerSecond.setIcon("mdi:filmstrip");
+  framesPerSecond.setUnitOfMeasurement("fps");
+  droppedFrames.setName("Dropped frames");
+  droppedFrames.setIcon("mdi:filmstrip-off");
+  lateFrames.setName("Late frames");
+  lateFrames.setIcon("mdi:timer-alert-outline");
+  showTime.setName("Show time");
+  showTime.setIcon("mdi:timer-outline");
+  showTime.setUnitOfMeasurement("us");
+  maximumShowTime.setName("Maximum show time");
+  maximumShowTime.setIcon("mdi:timer-outline");
+  maximumShowTime.setUnitOfMeasurement("us");
+  wifiSignal.setName("WiFi signal");
+  wifiSignal.setDeviceClass("signal_strength");
+  wifiSignal.setUnitOfMeasurement("dBm");
+  mqttRoundTrip.setName("MQTT round trip");
+  mqttRoundTrip.setIcon("mdi:swap-horizontal");
+  mqttRoundTrip.setUnitOfMeasurement("ms");
+
+  previewSwitch.onCommand(onPreviewCommand);
+  previewSwitch.setName("Live preview");
+  previewSwitch.setIcon("mdi:eye");
+
+  syncSelect.setOptions("Off;Leader;Follower");
+  syncSelect.onCommand(onSyncCommand);
+  syncSelect.setName("Synchronization");
+  syncSelect.setIcon("mdi:sync");
+
+  // The switches publish their state, when they are connected
+  animationsSwitch.setCurrentState(controller.animationsEnabled());
+#ifdef ZONES_AVAILABLE
+  zonesSwitch.setCurrentState(controller.zonesEnabled());
+#endif // ZONES_AVAILABLE
+
+#define X(field)                                                                   \
+  enable##field##Switch.setCurrentState(controller.is##field##Enabled());          \
+  weight##field##Number.setCurrentState(controller.animationWeight(Ferriswheel::field##Id));
 
-  controller.setMqtt(&mqtt);
+ENABLED_ANIMATIONS_LIST
+#undef X
 
-  mqtt.loop();
+  snprintf(scriptTopic, sizeof(scriptTopic), "riesenrad/%s/script", device.getUniqueId());
+  snprintf(pingTopic, sizeof(pingTopic), "riesenrad/%s/ping", device.getUniqueId());
+  snprintf(playlistTopic, sizeof(playlistTopic), "riesenrad/%s/playlist", device.getUniqueId());
+  snprintf(previewTopic, sizeof(previewTopic), "riesenrad/%s/preview", device.getUniqueId());
+  mqtt.onConnected(onMqttConnected);
+  mqtt.onMessage(onMqttMessage);
 
-  animationsSwitch.setState(controller.animationsEnabled());
+  // All entities are set up now
+  discoveryCache.begin(device.getUniqueId(), Config::NAME, softwareVersion);
 
-#define X(field)                                                   \
-  enable##field##Switch.setState(controller.is##field##Enabled()); \
+  mqtt.begin(Config::Secrets::BROKER_ADDR, Config::Secrets::MQTT_USER, Config::Secrets::MQTT_PASSWORD);
 
-ENABLED_ANIMATIONS_LIST
-#undef X
+  controller.setMqtt(&mqtt);
+  controller.onPublishStream(publishStream);
+  controller.onPublishFrameLevel(publishFrameLevel);
+  controller.onPublishPower(publishPower);
+  controller.onPublishDiagnostics(publishDiagnostics);
+  controller.onPublishPreview(publishPreview);
+  controller.beginStream();
+  controller.beginSync();
+  syncSelect.setCurrentState(static_cast<int8_t>(controller.syncRole()));
+
+  mqtt.loop();
 
   publishAnimation(nullptr);
+  publishFrameLevel(FrameGovernor::Level::Full);
   #else
 #ifdef MOTOR_AVAILABLE
   controller.setMotorEnabled(true);
@@ -0,0 +1,105 @@
+#include "motorphase.hpp"
+
+#if defined(MOTOR_AVAILABLE) && (defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR))
+
+MotorPhase::Motion MotorPhase::read() const {
+  Motion motion;
+  uint32_t sequence;
+  do {
+    sequence = _sequence.load(std::memory_order_acquire);
+    motion = _motion;
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 || sequence != _sequence.load(std::memory_order_relaxed));
+  return motion;
+}
+
+void MotorPhase::write(const Motion& motion) {
+  const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+  _sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  _motion = motion;
+  _sequence.store(sequence + 2, std::memory_order_release);
+}
+
+uint32_t MotorPhase::velocity(uint8_t duty) const {
+  // Modeled as proportional to the duty, corrected by the index pulses
+  return (uint64_t)MAX_VELOCITY * duty / Config::MAX_SPEED * _gain / UNITY_GAIN;
+}
+
+uint32_t MotorPhase::velocityAt(const Motion& motion, int64_t timeUs) {
+  const int64_t elapsedUs = timeUs - motion.startUs;
+  if (elapsedUs <= 0) {
+    return motion.startVelocity;
+  }
+  if (elapsedUs >= motion.durationUs) {
+    return motion.endVelocity;
+  }
+  const int64_t change = (int64_t)motion.endVelocity - motion.startVelocity;
+  return motion.startVelocity + change * elapsedUs / motion.durationUs;
+}
+
+uint32_t MotorPhase::phaseAt(const Motion& motion, int64_t timeUs) {
+  const int64_t elapsedUs = timeUs - motion.startUs;
+  if (elapsedUs <= 0) {
+    return motion.phase;
+  }
+  // The velocity changes linearly, so the distance is given by the average velocity
+  const int64_t rampUs = elapsedUs < motion.durationUs ? elapsedUs : motion.durationUs;
+  uint64_t distance = ((uint64_t)motion.startVelocity + velocityAt(motion, timeUs)) * rampUs / 2000;
+  distance += (uint64_t)motion.endVelocity * (elapsedUs - rampUs) / 1000;
+  return motion.phase + (uint32_t)distance;
+}
+
+void MotorPhase::segment(int64_t nowUs, uint8_t fromDuty, uint8_t toDuty, uint32_t durationMs) {
+  const Motion current = read();
+  write({ nowUs, phaseAt(current, nowUs), velocity(fromDuty), velocity(toDuty), durationMs * 1000 });
+  if (toDuty == 0) {
+    // The time until the next pulse says nothing about the velocity anymore
+    _lastPulseUs = -1;
+  }
+}
+
+void MotorPhase::indexPulse(int64_t pulseUs) {
+  const Motion current = read();
+  const int32_t error = -(int32_t)phaseAt(current, pulseUs);
+
+  // The wheel made exactly one revolution since the last pulse, so the error
+  // is also the error of the modeled velocity. Only half of it is corrected,
+  // to smooth out noise.
+  uint32_t ratio = UNITY_GAIN;
+  if (_lastPulseUs >= 0) {
+    ratio += (int64_t)UNITY_GAIN * error / (int64_t)(2 * REVOLUTION);
+    _gain = (uint64_t)_gain * ratio / UNITY_GAIN;
+  }
+  _lastPulseUs = pulseUs;
+
+  // Continue the current motion from the pulse, with the corrected velocity
+  int64_t remainingUs = (int64_t)current.durationUs - (pulseUs - current.startUs);
+  if (remainingUs < 0) {
+    remainingUs = 0;
+  }
+  write({
+    pulseUs,
+    0,
+    (uint32_t)((uint64_t)velocityAt(current, pulseUs) * ratio / UNITY_GAIN),
+    (uint32_t)((uint64_t)current.endVelocity * ratio / UNITY_GAIN),
+    (uint32_t)remainingUs,
+  });
+}
+
+void MotorPhase::indexPulse() {
+  int64_t pulseUs;
+  uint32_t sequence;
+  do {
+    sequence = _pulseSequence.load(std::memory_order_acquire);
+    pulseUs = _detectedPulseUs;
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 || sequence != _pulseSequence.load(std::memory_order_relaxed));
+  indexPulse(pulseUs);
+}
+
+uint32_t MotorPhase::phaseAt(int64_t timeUs) const {
+  return phaseAt(read(), timeUs);
+}
+
+#endif // MOTOR_AVAILABLE && (ARDUINO_ARCH_ESP32 || SIMULATOR)
@@ -0,0 +1,84 @@
+#include "motorprofile.hpp"
+
+#ifdef MOTOR_AVAILABLE
+
+namespace {
+
+// Position within a ramp from 0 to 256
+uint16_t curve(MotorProfile::Shape shape, uint8_t segment, uint8_t segments) {
+  const uint32_t t = (uint32_t)segment * 256 / segments;
+  if (shape == MotorProfile::Shape::Linear) {
+    return t;
+  }
+  // smoothstep: 3t² - 2t³
+  return (3 * t * t * 256 - 2 * t * t * t) / (256UL * 256);
+}
+
+}
+
+MotorProfile::Segment MotorProfile::hold(State state, uint8_t duty, uint32_t durationMs) {
+  _state = state;
+  _duty = duty;
+  _waiting = durationMs == FOREVER;
+  return { duty, durationMs, false };
+}
+
+MotorProfile::Segment MotorProfile::startRamp(State state, uint8_t from) {
+  _state = state;
+  _rampFrom = from;
+  _rampSegment = 0;
+  _waiting = false;
+  // Below MIN_SPEED the motor does not turn, so a ramp up starts there
+  // immediately.
+  _duty = from;
+  return { from, 0, false };
+}
+
+MotorProfile::Segment MotorProfile::rampSegment(uint8_t to) {
+  const uint8_t segments = _shape == Shape::SCurve ? SCURVE_SEGMENTS : 1;
+  _rampSegment++;
+  const int16_t distance = (int16_t)to - _rampFrom;
+  _duty = _rampFrom + distance * (int32_t)curve(_shape, _rampSegment, segments) / 256;
+  return { _duty, RAMP_MS / segments, true };
+}
+
+MotorProfile::Segment MotorProfile::next(bool enabled) {
+  const uint8_t segments = _shape == Shape::SCurve ? SCURVE_SEGMENTS : 1;
+  switch (_state) {
+  case State::Stopped:
+    if (!enabled) {
+      return hold(State::Stopped, 0, FOREVER);
+    }
+    return startRamp(State::RampUp, Config::MIN_SPEED);
+  case State::RampUp:
+    if (!enabled) {
+      return startRamp(State::RampDown, _duty);
+    }
+    if (_rampSegment < segments && _duty != Config::MAX_SPEED) {
+      return rampSegment(Config::MAX_SPEED);
+    }
+    return hold(State::Running, Config::MAX_SPEED, RUNNING_MS);
+  case State::Running:
+    return startRamp(State::RampDown, _duty);
+  case State::RampDown:
+    // A ramp without a change would not be ended by the hardware
+    if (_rampSegment < segments && _duty != Config::MIN_SPEED) {
+      return rampSegment(Config::MIN_SPEED);
+    }
+    return hold(State::Stopped, 0, STOPPED_MS);
+  }
+  return hold(State::Stopped, 0, FOREVER);
+}
+
+bool MotorProfile::interrupt(bool enabled) const {
+  switch (_state) {
+  case State::Stopped:
+    return enabled && _waiting;
+  case State::Running:
+    return !enabled;
+  default:
+    return false;
+  }
+}
+
+#endif // MOTOR_AVAILABLE
@@ -1,9 +1,10 @@
 #include "move.hpp"
 
-MoveAnimation::MoveAnimation() : _start(random8(NUM_LEDS)), _reverse(randomBool()) {}
+MoveAnimation::MoveAnimation()
+  : IterationAnimation(ledCount() + 1, framesPerMs<100>()), _start(randomBelow(ledCount())), _reverse(randomBool()) {}
 
 void MoveAnimation::step() {
-  constexpr uint8_t trail_length = NUM_LEDS / 10 + 1;
+  const uint8_t trail_length = ledCount() / 10 + 1;
 
   allBlack();
 
@@ -15,14 +16,14 @@ void MoveAnimation::step() {
       uint8_t index = getLedOffsetIndex(remaining_iterations, _start);
       index = getLedOffsetIndex(index, i, _reverse);
       if (i == 0) {
-        leds[index] = CRGB::Red;
+        firstLed()[index] = CRGB::Red;
       } else {
-        leds[index] = CRGB::Wheat;
+        firstLed()[index] = CRGB::Wheat;
       }
     }
 
     if (remaining_iterations < 4) {
-      fadeToBlackBy(leds, NUM_LEDS, 255 / remaining_iterations);
+      fadeToBlackBy(firstLed(), ledCount(), 255 / remaining_iterations);
     }
   }
   IterationAnimation::step();
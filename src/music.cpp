@@ -0,0 +1,67 @@
+#include "music.hpp"
+
+#ifdef AUDIO_AVAILABLE
+
+#include <FastLED.h>
+
+namespace {
+
+// The music animations are shown for 30 seconds
+constexpr uint16_t STEP_MS = 20;
+constexpr uint16_t DURATION_STEPS = 30000 / STEP_MS;
+
+}
+
+BandBarsAnimation::BandBarsAnimation()
+  : FrameAnimation(framesPerMs<STEP_MS>()), _remainingSteps(DURATION_STEPS) {
+}
+
+void BandBarsAnimation::step() {
+  uint8_t bands[AudioAnalyzer::BANDS];
+  audioInput.read(bands);
+
+  const uint8_t sectorLeds = sectorLength();
+  for (uint8_t band = 0; band < AudioAnalyzer::BANDS; band++) {
+    _levels[band] = max(bands[band], qsub8(_levels[band], 12));
+    const uint8_t length = ((uint16_t)_levels[band] * sectorLeds + 0x80) >> 8;
+    const CRGB color = CHSV(band * (0x100 / AudioAnalyzer::BANDS), 0xff, 0xff);
+    CRGB* const sector = &firstLed()[band * sectorLeds];
+    for (uint8_t led = 0; led < sectorLeds; led++) {
+      sector[led] = led < length ? color : CRGB(CRGB::Black);
+    }
+  }
+  _remainingSteps--;
+}
+
+BeatSprinkleAnimation::BeatSprinkleAnimation()
+  : FrameAnimation(framesPerMs<STEP_MS>()), _remainingSteps(DURATION_STEPS), _hue(randomByte()) {
+}
+
+void BeatSprinkleAnimation::start() {
+  // Only beats from now on throw sprinkles
+  uint8_t bands[AudioAnalyzer::BANDS];
+  _beats = audioInput.read(bands);
+}
+
+void BeatSprinkleAnimation::step() {
+  fadeToBlackBy(firstLed(), ledCount(), 24);
+
+  uint8_t bands[AudioAnalyzer::BANDS];
+  const uint32_t beats = audioInput.read(bands);
+  if (beats != _beats) {
+    _beats = beats;
+    _hue += 40;
+    // Louder bass throws more sprinkles
+    uint8_t count = 8 + bands[0] / 16;
+    while (count-- > 0) {
+      firstLed()[randomBelow(ledCount())] = CHSV(_hue + randomBelow(32), 0xc0, 0xff);
+    }
+  }
+  // The treble adds some glitter between the beats
+  if (bands[AudioAnalyzer::BANDS - 1] > 0xc0) {
+    firstLed()[randomBelow(ledCount())] = CRGB::White;
+  }
+  _remainingSteps--;
+}
+
+#endif // AUDIO_AVAILABLE
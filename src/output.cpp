@@ -0,0 +1,101 @@
+#include "output.hpp"
+
+#include "config.hpp"
+#include "tables.hpp"
+
+void OutputStage::setScale(uint16_t scale) {
+  _scale = scale;
+  _channelScales[0] = (uint32_t)scale * (uint8_t)(Config::COLOR_CORRECTION >> 16) / 0xff;
+  _channelScales[1] = (uint32_t)scale * (uint8_t)(Config::COLOR_CORRECTION >> 8) / 0xff;
+  _channelScales[2] = (uint32_t)scale * (uint8_t)Config::COLOR_CORRECTION / 0xff;
+}
+
+#ifdef OUTPUT_STAGE_AVAILABLE
+
+namespace {
+
+constexpr uint32_t squareRoot(uint32_t value, uint32_t low = 0, uint32_t high = 0x10000) {
+  return high - low <= 1 ? low
+    : (uint64_t)((low + high) / 2) * ((low + high) / 2) <= value
+      ? squareRoot(value, (low + high) / 2, high)
+      : squareRoot(value, low, (low + high) / 2);
+}
+
+// 0xffff * (value / 255) ^ 2.25, as the square multiplied with the fourth root
+constexpr uint16_t calculateGamma(uint8_t value) {
+  return !Config::GAMMA_CORRECTION
+    ? value * 0x101
+    : (uint32_t)value * value * 0xffff / (255 * 255) * squareRoot(squareRoot(value * 0x101UL * 0xffff) * 0xffff) / 0xffff;
+}
+
+struct GammaCurve {
+  typedef uint16_t type;
+  static constexpr uint16_t size = 256;
+  static constexpr uint16_t value(uint16_t index) { return calculateGamma(index); }
+};
+
+typedef Table<GammaCurve> Gamma;
+
+static_assert(calculateGamma(0) == 0 && calculateGamma(255) == 0xffff, "The gamma table must cover the full range");
+
+// Thresholds of successive frames are spread like 0, 128, 64, 192, ... so that
+// even a short sequence of frames averages to the fraction
+uint8_t reverseBits(uint8_t value) {
+  value = (value & 0xf0) >> 4 | (value & 0x0f) << 4;
+  value = (value & 0xcc) >> 2 | (value & 0x33) << 2;
+  return (value & 0xaa) >> 1 | (value & 0x55) << 1;
+}
+
+// Added to the threshold for every LED, so that neighbours do not step at the
+// same frame. Odd, so that every LED still gets all thresholds.
+constexpr uint8_t LED_THRESHOLD_STEP = 0x9f;
+
+}
+
+void OutputStage::render(const uint8_t* frame, uint8_t* output, uint8_t count, uint8_t rotation) {
+  // Without dithering the levels are rounded
+  uint8_t threshold = Config::TEMPORAL_DITHERING ? reverseBits(_frame++) : 0x80;
+  uint16_t sums[3] = { 0, 0, 0 };
+  uint8_t fractions = 0;
+  const uint8_t* const end = frame + (uint16_t)count * 3;
+  const uint8_t* source = frame + (uint16_t)(rotation % count) * 3;
+  for (uint8_t led = 0; led < count; led++) {
+    if (source == end) {
+      source = frame;
+    }
+    for (uint8_t channel = 0; channel < 3; channel++) {
+      const uint16_t level = (uint32_t)pgm_read_word(&Gamma::values[source[channel]]) * _channelScales[channel] >> 16;
+      fractions |= (uint8_t)level;
+      uint8_t value = level >> 8;
+      if ((uint8_t)level + threshold > 0xff && value < 0xff) {
+        value++;
+      }
+      output[channel] = value;
+      sums[channel] += value;
+    }
+    source += 3;
+    output += 3;
+    threshold += LED_THRESHOLD_STEP;
+  }
+  _sums.red = sums[0];
+  _sums.green = sums[1];
+  _sums.blue = sums[2];
+  _dithering = Config::TEMPORAL_DITHERING && fractions != 0;
+}
+
+#else
+
+void OutputStage::measure(const uint8_t* frame, uint8_t count) {
+  uint16_t sums[3] = { 0, 0, 0 };
+  for (uint8_t led = 0; led < count; led++) {
+    for (uint8_t channel = 0; channel < 3; channel++) {
+      sums[channel] += frame[channel];
+    }
+    frame += 3;
+  }
+  _sums.red = (uint32_t)sums[0] * _channelScales[0] >> 16;
+  _sums.green = (uint32_t)sums[1] * _channelScales[1] >> 16;
+  _sums.blue = (uint32_t)sums[2] * _channelScales[2] >> 16;
+}
+
+#endif // OUTPUT_STAGE_AVAILABLE
@@ -0,0 +1,44 @@
+#include "power.hpp"
+
+namespace {
+
+// Current of a WS2812B at full brightness per channel and of a dark LED,
+// like the defaults of FastLED's power functions
+constexpr uint8_t RED_MA = 16;
+constexpr uint8_t GREEN_MA = 11;
+constexpr uint8_t BLUE_MA = 15;
+constexpr uint8_t IDLE_MA = 1;
+
+constexpr uint16_t IDLE_TOTAL_MA = NUM_LEDS * IDLE_MA;
+static_assert(Config::POWER_BUDGET_MA == 0 || Config::POWER_BUDGET_MA > IDLE_TOTAL_MA,
+              "The power budget must be above the current of the dark strip");
+
+}
+
+uint16_t PowerLimiter::limit(const OutputStage::Sums& sums, uint16_t scale) {
+  // Current of the lit channels, in mA * 255
+  const uint32_t lit = (uint32_t)sums.red * RED_MA + (uint32_t)sums.green * GREEN_MA + (uint32_t)sums.blue * BLUE_MA;
+  uint16_t milliamps = lit / 255;
+
+  if (Config::POWER_BUDGET_MA > 0 && milliamps + IDLE_TOTAL_MA > Config::POWER_BUDGET_MA) {
+    const uint16_t available = Config::POWER_BUDGET_MA - IDLE_TOTAL_MA;
+    scale = (uint32_t)scale * available / milliamps;
+    milliamps = available;
+    _limitedFrames++;
+  }
+
+  _milliamps = milliamps + IDLE_TOTAL_MA;
+  _milliampsSum += _milliamps;
+  _frames++;
+  if (_milliamps > _maximumMilliamps) {
+    _maximumMilliamps = _milliamps;
+  }
+  return scale;
+}
+
+void PowerLimiter::resetStatistics() {
+  _milliampsSum = 0;
+  _frames = 0;
+  _maximumMilliamps = 0;
+  _limitedFrames = 0;
+}
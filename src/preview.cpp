@@ -0,0 +1,66 @@
+#include "preview.hpp"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace {
+
+// Must match PALETTE in tools/decode_preview.py
+const CRGB palette[16] = {
+  CRGB::Black,  CRGB::Red,     CRGB::Yellow,  CRGB::Green,
+  CRGB::Ivory,  CRGB::Blue,    CRGB::Cyan,    CRGB::Magenta,
+  CRGB::Orange, CRGB::White,   CRGB::Purple,  CRGB::Pink,
+  CRGB::Maroon, CRGB::DarkGreen, CRGB::Navy,  CRGB::Gray,
+};
+
+uint8_t nearestColor(const CRGB& color) {
+  uint8_t nearest = 0;
+  uint32_t nearestDistance = 0xffffffff;
+  for (uint8_t i = 0; i < 16; i++) {
+    const int16_t r = color.r - palette[i].r;
+    const int16_t g = color.g - palette[i].g;
+    const int16_t b = color.b - palette[i].b;
+    const uint32_t distance = (int32_t)r * r + (int32_t)g * g + (int32_t)b * b;
+    if (distance < nearestDistance) {
+      nearest = i;
+      nearestDistance = distance;
+    }
+  }
+  return nearest;
+}
+
+}
+
+namespace Ferriswheel
+{
+
+static_assert(Config::PREVIEW_BUCKETS > 0 && Config::PREVIEW_BUCKETS <= NUM_LEDS,
+              "Every preview bucket needs at least one LED");
+
+uint8_t FramePreview::encode(const CRGB* frame, uint8_t (&output)[MAX_SIZE]) {
+  uint8_t size = 0;
+  output[size++] = Config::PREVIEW_BUCKETS;
+  uint8_t led = 0;
+  for (uint8_t bucket = 0; bucket < Config::PREVIEW_BUCKETS; bucket++) {
+    const uint8_t end = (uint16_t)(bucket + 1) * NUM_LEDS / Config::PREVIEW_BUCKETS;
+    const uint8_t count = end - led;
+    uint16_t r = 0, g = 0, b = 0;
+    for (; led < end; led++) {
+      r += frame[led].r;
+      g += frame[led].g;
+      b += frame[led].b;
+    }
+    const uint8_t color = nearestColor(CRGB(r / count, g / count, b / count));
+
+    // Extends the previous run, when it has the same color and is not full
+    if (size > 1 && (output[size - 1] & 0x0f) == color && output[size - 1] < 0xf0) {
+      output[size - 1] += 0x10;
+    } else {
+      output[size++] = color;
+    }
+  }
+  return size;
+}
+
+};
+
+#endif // ARDUINO_ARCH_ESP32
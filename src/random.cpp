@@ -0,0 +1,49 @@
+#include "random.hpp"
+
+namespace {
+
+// Any value except 0
+uint32_t state = 0x2545f491;
+
+uint32_t next() {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+}
+
+void seedRandom(uint32_t seed) {
+  state = seed != 0 ? seed : 0x2545f491;
+}
+
+uint32_t randomState() {
+  return state;
+}
+
+uint8_t randomByte() {
+  return next() >> 24;
+}
+
+uint16_t randomWord() {
+  return next() >> 16;
+}
+
+// Lemire's method: the high half of the product is the value. Products whose
+// low half is below 65536 % limit would make some values more likely, they are
+// drawn again. The remainder is only needed when the low half is below limit.
+uint16_t randomBelow16(uint16_t limit) {
+  uint32_t product = (uint32_t)randomWord() * limit;
+  if ((uint16_t)product < limit) {
+    const uint16_t threshold = (uint16_t)-limit % limit;
+    while ((uint16_t)product < threshold) {
+      product = (uint32_t)randomWord() * limit;
+    }
+  }
+  return product >> 16;
+}
+
+uint8_t randomBelow(uint8_t limit) {
+  return randomBelow16(limit);
+}
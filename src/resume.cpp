@@ -0,0 +1,127 @@
+#include "resume.hpp"
+
+#ifdef RESUME_AVAILABLE
+
+#include <stddef.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_ota_ops.h>
+#endif
+
+#include "random.hpp"
+
+#if !defined(ARDUINO_ARCH_ESP32) && !defined(SIMULATOR)
+// End of the program and the initial values of .data in flash, from the
+// linker script
+extern "C" const uint8_t __data_load_end[];
+#endif
+
+namespace {
+
+#ifdef SIMULATOR
+constexpr uint32_t hash(const char* text, uint32_t value = 2166136261UL) {
+  return *text ? hash(text + 1, (value ^ (uint8_t)*text) * 16777619UL) : value;
+}
+#endif
+
+// Any change of the firmware changes the addresses the checkpoint refers to,
+// so the identifier has to change with every file of it. It is never 0,
+// which marks a cleared checkpoint.
+uint32_t calculateBuild() {
+#if defined(ARDUINO_ARCH_ESP32)
+  // The SHA-256 of the ELF file, which the build writes into the image
+  const uint8_t* const sha = esp_ota_get_app_description()->app_elf_sha256;
+  return (uint32_t)sha[0] << 24 | (uint32_t)sha[1] << 16 | sha[2] << 8 | sha[3] | 1;
+#elif defined(SIMULATOR)
+  // Nothing survives the process on the host
+  return hash(__DATE__ " " __TIME__) | 1;
+#else
+  // The sums of a Fletcher checksum over the whole program in flash, once per
+  // start. They overflow, which does not matter for an identifier.
+  uint32_t sum1 = 0;
+  uint32_t sum2 = 0;
+  for (uintptr_t address = 0; address < (uintptr_t)__data_load_end; address++) {
+    sum1 += pgm_read_byte(address);
+    sum2 += sum1;
+  }
+  return (sum2 ^ sum1 << 16) | 1;
+#endif
+}
+
+uint32_t build() {
+  static uint32_t value = 0;
+  if (value == 0) {
+    value = calculateBuild();
+  }
+  return value;
+}
+
+struct Checkpoint {
+  uint32_t build;
+  uint32_t random;
+  uint8_t animation;
+  uint8_t brightness;
+  uint8_t data[AnimationBuffer::capacity()];
+#ifndef RESUME_KEEPS_LEDS
+  uint8_t leds[NUM_LEDS * 3];
+#endif
+  uint16_t checksum;
+};
+
+RESUME_NOINIT Checkpoint checkpoint;
+
+// Fletcher-16 over everything before the checksum. The sums cannot overflow
+// for a checkpoint of this size, so they are only reduced at the end.
+uint16_t calculateChecksum() {
+  const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(&checkpoint);
+  uint32_t sum1 = 0;
+  uint32_t sum2 = 0;
+  for (uint16_t i = 0; i < offsetof(Checkpoint, checksum); i++) {
+    sum1 += bytes[i];
+    sum2 += sum1;
+  }
+  return (sum2 % 0xff) << 8 | sum1 % 0xff;
+}
+
+}
+
+bool ResumePoint::available() const {
+  return checkpoint.build == build() && checkpoint.checksum == calculateChecksum();
+}
+
+void ResumePoint::save(uint8_t animation, const AnimationBuffer& buffer, uint8_t brightness) {
+  checkpoint.build = build();
+  checkpoint.random = randomState();
+  checkpoint.animation = animation;
+  checkpoint.brightness = brightness;
+  memcpy(checkpoint.data, buffer.data(), sizeof(checkpoint.data));
+#ifndef RESUME_KEEPS_LEDS
+  memcpy(checkpoint.leds, leds, sizeof(checkpoint.leds));
+#endif
+  checkpoint.checksum = calculateChecksum();
+}
+
+void ResumePoint::clear() {
+  checkpoint.build = 0;
+}
+
+uint8_t ResumePoint::animation() const {
+  return checkpoint.animation;
+}
+
+uint8_t ResumePoint::brightness() const {
+  return checkpoint.brightness;
+}
+
+bool ResumePoint::restore(AnimationBuffer& buffer) {
+  if (!available() || !buffer.restore(checkpoint.data)) {
+    return false;
+  }
+#ifndef RESUME_KEEPS_LEDS
+  memcpy(leds, checkpoint.leds, sizeof(checkpoint.leds));
+#endif
+  seedRandom(checkpoint.random);
+  return true;
+}
+
+#endif // RESUME_AVAILABLE
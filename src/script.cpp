@@ -0,0 +1,322 @@
+#include "script.hpp"
+#include "geometry.hpp"
+
+// tools/script_benchmark.cpp runs the interpreter on the host
+#if defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR)
+
+#include <algorithm>
+#include <freertos/task.h>
+
+Script::Program scriptProgram;
+
+namespace {
+
+portMUX_TYPE programLock = portMUX_INITIALIZER_UNLOCKED;
+
+uint8_t ledIndex(int32_t index) {
+  index %= ledCount();
+  if (index < 0) {
+    index += ledCount();
+  }
+  return index;
+}
+
+uint8_t clampLength(uint8_t start, int32_t length) {
+  if (length < 0) {
+    return 0;
+  }
+  return min(length, (int32_t)(ledCount() - start));
+}
+
+int32_t fromColor(const CRGB& color) {
+  return (int32_t)color.r << 16 | (int32_t)color.g << 8 | color.b;
+}
+
+}
+
+bool Script::Program::upload(const uint8_t* code, uint16_t size) {
+  if (size <= HEADER_SIZE || size > MAX_SIZE || code[0] != 'R' || code[1] != 'B' || code[2] != VERSION) {
+    return false;
+  }
+  portENTER_CRITICAL(&programLock);
+  memcpy(_code, code, size);
+  _size = size;
+  portEXIT_CRITICAL(&programLock);
+  return true;
+}
+
+uint8_t Script::Program::copy(uint8_t (&code)[MAX_SIZE]) const {
+  portENTER_CRITICAL(&programLock);
+  const uint8_t size = _size;
+  memcpy(code, _code, size);
+  portEXIT_CRITICAL(&programLock);
+  return size;
+}
+
+ScriptAnimation::ScriptAnimation() : DynamicFrameAnimation(Animation::frameMs) {
+  _size = scriptProgram.copy(_code);
+  _finished = _size == 0;
+}
+
+uint16_t ScriptAnimation::fail(const char* reason, uint16_t pc) {
+  Serial.printf("Script stopped at %u: %s\n", pc, reason);
+  _finished = true;
+  return 0;
+}
+
+uint16_t ScriptAnimation::step() {
+  using namespace Script;
+
+  struct Loop {
+    uint16_t start;
+    int32_t counter;
+    int32_t count;
+  };
+
+  if (_finished) {
+    return 0;
+  }
+
+  const uint8_t* const code = _code;
+  const uint16_t size = _size;
+  int32_t stack[STACK_SIZE];
+  uint8_t sp = 0;
+  Loop loops[LOOP_DEPTH];
+  uint8_t loopDepth = 0;
+  uint16_t pc = HEADER_SIZE;
+
+#define REQUIRE(count)                          \
+  if (sp < (count)) {                           \
+    return fail("Stack underflow", pc - 1);     \
+  }
+#define PUSH(value)                             \
+  if (sp >= STACK_SIZE) {                       \
+    return fail("Stack overflow", pc - 1);      \
+  }                                             \
+  {                                             \
+    const int32_t pushed = (value);             \
+    stack[sp++] = pushed;                       \
+  }
+#define IMMEDIATE(bytes)                        \
+  if (pc + (bytes) > size) {                    \
+    return fail("Truncated instruction", pc - 1); \
+  }
+#define BINARY(expression)                      \
+  {                                             \
+    REQUIRE(2);                                 \
+    const int32_t b = stack[--sp];              \
+    int32_t& a = stack[sp - 1];                 \
+    a = (int32_t)(expression);                  \
+    break;                                      \
+  }
+
+  for (uint16_t instructions = 0; instructions < MAX_INSTRUCTIONS; instructions++) {
+    if (pc >= size) {
+      return fail("Missing END", pc);
+    }
+    switch (code[pc++]) {
+    case END:
+      _finished = true;
+      return 0;
+    case YIELD: {
+      REQUIRE(1);
+      _steps++;
+      const int32_t delay = stack[--sp];
+      return constrain(delay, Animation::frameMs, 0xfe * Animation::frameMs);
+    }
+    case PUSH8:
+      IMMEDIATE(1);
+      PUSH(code[pc]);
+      pc += 1;
+      break;
+    case PUSH16:
+      IMMEDIATE(2);
+      PUSH((int16_t)(code[pc] | code[pc + 1] << 8));
+      pc += 2;
+      break;
+    case PUSH24:
+      IMMEDIATE(3);
+      PUSH(code[pc] | code[pc + 1] << 8 | code[pc + 2] << 16);
+      pc += 3;
+      break;
+    case DUP:
+      REQUIRE(1);
+      PUSH(stack[sp - 1]);
+      break;
+    case DROP:
+      REQUIRE(1);
+      sp--;
+      break;
+    case SWAP:
+      REQUIRE(2);
+      std::swap(stack[sp - 1], stack[sp - 2]);
+      break;
+    case OVER:
+      REQUIRE(2);
+      PUSH(stack[sp - 2]);
+      break;
+
+    // Uploaded programs may overflow, so the arithmetic wraps around like
+    // uint32_t instead of being undefined for int32_t. INT32_MIN / -1 would
+    // trap and is negated instead.
+    case ADD: BINARY((uint32_t)a + (uint32_t)b)
+    case SUB: BINARY((uint32_t)a - (uint32_t)b)
+    case MUL: BINARY((uint32_t)a * (uint32_t)b)
+    case DIV: BINARY(b == 0 ? 0 : b == -1 ? 0 - (uint32_t)a : a / b)
+    case MOD: BINARY(b == 0 || b == -1 ? 0 : a % b)
+    case AND: BINARY(a & b)
+    case OR: BINARY(a | b)
+    case XOR: BINARY(a ^ b)
+    case SHL: BINARY((uint32_t)a << (b & 0x1f))
+    case SHR: BINARY(a >> (b & 0x1f))
+    case LT: BINARY(a < b)
+    case EQ: BINARY(a == b)
+    case NOT:
+      REQUIRE(1);
+      stack[sp - 1] = !stack[sp - 1];
+      break;
+
+    case JMP:
+      IMMEDIATE(2);
+      pc = code[pc] | code[pc + 1] << 8;
+      break;
+    case JZ:
+    case JNZ: {
+      IMMEDIATE(2);
+      REQUIRE(1);
+      const bool isZero = stack[--sp] == 0;
+      if (isZero == (code[pc - 1] == JZ)) {
+        pc = code[pc] | code[pc + 1] << 8;
+      } else {
+        pc += 2;
+      }
+      break;
+    }
+    case FOR: {
+      IMMEDIATE(2);
+      REQUIRE(1);
+      const int32_t count = stack[--sp];
+      if (count <= 0) {
+        pc = code[pc] | code[pc + 1] << 8;
+      } else if (loopDepth >= LOOP_DEPTH) {
+        return fail("Loops nested too deep", pc - 1);
+      } else {
+        pc += 2;
+        loops[loopDepth++] = { pc, 0, count };
+      }
+      break;
+    }
+    case NEXT:
+      if (loopDepth == 0) {
+        return fail("NEXT without FOR", pc - 1);
+      }
+      if (++loops[loopDepth - 1].counter < loops[loopDepth - 1].count) {
+        pc = loops[loopDepth - 1].start;
+      } else {
+        loopDepth--;
+      }
+      break;
+    case INDEX:
+      if (loopDepth == 0) {
+        return fail("INDEX outside of a loop", pc - 1);
+      }
+      PUSH(loops[loopDepth - 1].counter);
+      break;
+
+    case LOAD:
+      IMMEDIATE(1);
+      PUSH(_registers[code[pc] % REGISTER_COUNT]);
+      pc += 1;
+      break;
+    case STORE:
+      IMMEDIATE(1);
+      REQUIRE(1);
+      _registers[code[pc] % REGISTER_COUNT] = stack[--sp];
+      pc += 1;
+      break;
+    case STEP:
+      PUSH(_steps);
+      break;
+    case RANDOM:
+      REQUIRE(1);
+      stack[sp - 1] = randomBelow16(stack[sp - 1]);
+      break;
+    case LEDS:
+      PUSH(ledCount());
+      break;
+    case ANGLE:
+      REQUIRE(1);
+      stack[sp - 1] = geometry::angleOfLed(firstLed() - leds + ledIndex(stack[sp - 1]));
+      break;
+    case AT_ANGLE:
+      REQUIRE(1);
+      stack[sp - 1] = geometry::ledAtAngle(stack[sp - 1] & 0xff) - (firstLed() - leds);
+      break;
+
+    case SIN8:
+      REQUIRE(1);
+      stack[sp - 1] = sin8(stack[sp - 1]);
+      break;
+    case SCALE8: BINARY(scale8(a, b))
+    case HSV: {
+      REQUIRE(3);
+      sp -= 2;
+      const CRGB color = CHSV(stack[sp - 1], stack[sp], stack[sp + 1]);
+      stack[sp - 1] = fromColor(color);
+      break;
+    }
+
+    case GET:
+      REQUIRE(1);
+      stack[sp - 1] = fromColor(firstLed()[ledIndex(stack[sp - 1])]);
+      break;
+    case SET:
+      REQUIRE(2);
+      sp -= 2;
+      firstLed()[ledIndex(stack[sp])] = CRGB((uint32_t)stack[sp + 1]);
+      break;
+    case FILL: {
+      REQUIRE(3);
+      sp -= 3;
+      const uint8_t start = ledIndex(stack[sp]);
+      fill_solid(&firstLed()[start], clampLength(start, stack[sp + 1]), CRGB((uint32_t)stack[sp + 2]));
+      break;
+    }
+    case GRADIENT: {
+      REQUIRE(4);
+      sp -= 4;
+      const uint8_t start = ledIndex(stack[sp]);
+      const uint8_t length = clampLength(start, stack[sp + 1]);
+      if (length > 0) {
+        fill_gradient_RGB(&firstLed()[start], length, CRGB((uint32_t)stack[sp + 2]), CRGB((uint32_t)stack[sp + 3]));
+      }
+      break;
+    }
+    case FADE:
+      REQUIRE(1);
+      fadeToBlackBy(firstLed(), ledCount(), stack[--sp]);
+      break;
+    case ROTATE:
+      REQUIRE(1);
+      std::rotate(firstLed(), firstLed() + ledIndex(stack[--sp]), firstLed() + ledCount());
+      break;
+    case BLEND:
+      REQUIRE(3);
+      sp -= 3;
+      nblend(firstLed()[ledIndex(stack[sp])], CRGB((uint32_t)stack[sp + 1]), stack[sp + 2]);
+      break;
+
+    default:
+      return fail("Unknown opcode", pc - 1);
+    }
+  }
+
+#undef BINARY
+#undef IMMEDIATE
+#undef PUSH
+#undef REQUIRE
+
+  return fail("Too many instructions", pc);
+}
+
+#endif // ARDUINO_ARCH_ESP32 || SIMULATOR
@@ -0,0 +1,142 @@
+#include "sequence.hpp"
+#include "sequence_data.hpp"
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_partition.h>
+#endif
+
+namespace {
+
+const uint8_t* const builtinSequences[] = {
+  cometSequence,
+};
+
+#ifdef ARDUINO_ARCH_ESP32
+// Sequences flashed into the "sequences" data partition, mapped into the address space once
+const uint8_t* mappedSequences(uint32_t& size) {
+  static const uint8_t* mapped = nullptr;
+  static uint32_t mappedSize = 0;
+  static bool searched = false;
+  if (!searched) {
+    searched = true;
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "sequences");
+    if (partition) {
+      const void* data;
+      spi_flash_mmap_handle_t handle;
+      if (esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &data, &handle) == ESP_OK) {
+        mapped = static_cast<const uint8_t*>(data);
+        mappedSize = partition->size;
+      }
+    }
+  }
+  size = mappedSize;
+  return mapped;
+}
+#endif
+
+}
+
+SequenceAnimation::SequenceAnimation(const uint8_t* sequence)
+  : DynamicFrameAnimation(Animation::frameMs)
+  , _frameDelay(0)
+  , _remainingFrames(0) {
+  if (sequence && isValid(sequence)) {
+    _frameDelay = pgm_read_byte(&sequence[4]) | pgm_read_byte(&sequence[5]) << 8;
+    _remainingFrames = pgm_read_byte(&sequence[6]) | pgm_read_byte(&sequence[7]) << 8;
+    _position = sequence + HEADER_SIZE;
+  }
+}
+
+const uint8_t* SequenceAnimation::randomSequence() {
+  uint8_t count = array_size(builtinSequences);
+#ifdef ARDUINO_ARCH_ESP32
+  uint32_t size;
+  const uint8_t* mapped = mappedSequences(size);
+  const uint8_t* const mappedEnd = mapped + size;
+  for (const uint8_t* sequence = mapped; sequence && sequence + HEADER_SIZE <= mappedEnd && isValid(sequence);
+       sequence += totalSize(sequence)) {
+    count++;
+  }
+#endif
+
+  uint8_t selected = randomBelow(count);
+  if (selected < array_size(builtinSequences)) {
+    return builtinSequences[selected];
+  }
+#ifdef ARDUINO_ARCH_ESP32
+  selected -= array_size(builtinSequences);
+  const uint8_t* sequence = mapped;
+  while (selected-- > 0) {
+    sequence += totalSize(sequence);
+  }
+  return sequence;
+#else
+  return nullptr;
+#endif
+}
+
+bool SequenceAnimation::isValid(const uint8_t* sequence) {
+  return pgm_read_byte(&sequence[0]) == 'R' && pgm_read_byte(&sequence[1]) == 'S' &&
+         pgm_read_byte(&sequence[2]) == VERSION && pgm_read_byte(&sequence[3]) == NUM_LEDS;
+}
+
+uint32_t SequenceAnimation::totalSize(const uint8_t* sequence) {
+  uint32_t size = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    size |= (uint32_t)pgm_read_byte(&sequence[8 + i]) << (8 * i);
+  }
+  return HEADER_SIZE + size;
+}
+
+uint8_t SequenceAnimation::read() {
+  return pgm_read_byte(_position++);
+}
+
+CRGB SequenceAnimation::readColor() {
+  const uint8_t r = read();
+  const uint8_t g = read();
+  const uint8_t b = read();
+  return CRGB(r, g, b);
+}
+
+uint16_t SequenceAnimation::step() {
+  if (_remainingFrames == 0) {
+    return 0;
+  }
+
+  uint16_t delay = _frameDelay;
+  // The frames cover the whole strip, in a zone they are shrunk to its LEDs
+  const uint16_t scale = (uint16_t)ledCount() * 0x100 / NUM_LEDS;
+  CRGB* const strip = firstLed();
+  uint8_t led = 0;
+  while (led < NUM_LEDS) {
+    const uint8_t run = read();
+    uint8_t length = (run & 0x3f) + 1;
+    if (length > NUM_LEDS - led) {
+      length = NUM_LEDS - led;
+    }
+    switch (run & 0xc0) {
+      case 0x00:
+        break;
+      case 0x40: {
+        const CRGB color = readColor();
+        for (uint8_t i = 0; i < length; i++) {
+          strip[(led + i) * scale >> 8] = color;
+        }
+        break;
+      }
+      case 0x80:
+        for (uint8_t i = 0; i < length; i++) {
+          strip[(led + i) * scale >> 8] = readColor();
+        }
+        break;
+      case 0xc0:
+        delay = _frameDelay * length;
+        length = NUM_LEDS - led;
+        break;
+    }
+    led += length;
+  }
+  _remainingFrames--;
+  return delay;
+}
@@ -5,7 +5,7 @@ void SnakeAnimation::step() {
       shrink();
     } else {
       move();
-      if (_length >= maxLength) {
+      if (_length >= maxLength()) {
         _shrinking = true;
       }
     }
@@ -20,7 +20,7 @@ void SnakeAnimation::shrink() {
 void SnakeAnimation::move() {
   uint8_t missingApples = maxApples - apples.count();
   if (missingApples > 0) {
-    uint8_t remainingLengthUnfed = maxLength - _length - apples.count();
+    uint8_t remainingLengthUnfed = maxLength() - _length - apples.count();
     if (remainingLengthUnfed < missingApples) {
       missingApples = remainingLengthUnfed;
     }
@@ -29,14 +29,15 @@ void SnakeAnimation::move() {
     uint8_t index = 0;
     uint8_t newApple;
     do {
-      newApple = random8(NUM_LEDS);
+      newApple = randomBelow(ledCount());
       index = snakeIndex(newApple);
     } while(index < _length || apples[newApple]);
     apples.set(newApple);
   }
 
   // draw current state
-  for (uint8_t led = 0; led < NUM_LEDS; led++) {
+  const uint8_t count = ledCount();
+  for (uint8_t led = 0; led < count; led++) {
     CRGB color;
     if (led == _position) {
       color = head;
@@ -50,8 +51,8 @@ void SnakeAnimation::move() {
         color = CRGB::Black;
       }
     }
-    const uint8_t actualIndex = _reverse ? NUM_LEDS - led - 1 : led;
-    leds[actualIndex] = color;
+    const uint8_t actualIndex = _reverse ? count - led - 1 : led;
+    firstLed()[actualIndex] = color;
   }
   if (apples.reset(_position)) {
     _length++;
@@ -59,7 +60,7 @@ void SnakeAnimation::move() {
   if (_position > 0) {
     _position -= 1;
   } else {
-    _position = NUM_LEDS - 1;
+    _position = count - 1;
   }
 }
 
@@ -67,7 +68,7 @@ uint8_t SnakeAnimation::snakeIndex(const uint8_t index) const {
   uint8_t relative = index - _position;
   // if index < position -> the index "would be" the number of leds higher
   if (index < _position) {
-    relative += NUM_LEDS;
+    relative += ledCount();
   }
   return relative;
 }
\ No newline at end of file
@@ -45,25 +45,25 @@ bool SprinkleState::step() {
   }
   CRGB color = CRGB::White;
   color.fadeToBlackBy(_dimFactor);
-  leds[_led] = color;
+  firstLed()[_led] = color;
 
   return hasStopped;
 }
 
-SprinkleAnimation::SprinkleAnimation() {
+SprinkleAnimation::SprinkleAnimation() : FrameAnimation(framesPerMs<50>()) {
 }
 
 void SprinkleAnimation::step() {
-  uint8_t placementTests = num_sprinkles - _sprinkles;
+  uint8_t placementTests = ledCount() / 2 - _sprinkles;
   while (placementTests-- > 0) {
-    if (_remainingSprinkles > _sprinkles && random8() < 50) {
+    if (_remainingSprinkles > _sprinkles && randomByte() < 50) {
       // Try to get a new LED for a new sprinkle
       bool isUnique;
       uint8_t newLed;
       uint8_t freeIndex;
       do {
         isUnique = true;
-        newLed = random8(NUM_LEDS);
+        newLed = randomBelow(ledCount());
 
         freeIndex = num_sprinkles;
         for (uint8_t sprinkleLed = 0; sprinkleLed < num_sprinkles; sprinkleLed++) {
@@ -79,7 +79,7 @@ void SprinkleAnimation::step() {
       } while (!isUnique);
 
       if (freeIndex < num_sprinkles) {
-        _sprinkleLeds[freeIndex].init(newLed, random8(10, 50));
+        _sprinkleLeds[freeIndex].init(newLed, randomBetween(10, 50));
         _sprinkles++;
       }
     }
@@ -0,0 +1,46 @@
+#include "stackpaint.hpp"
+
+#ifndef ARDUINO_ARCH_ESP32
+
+// Provided by the linker script and avr-libc
+extern uint8_t _end;
+extern uint8_t __stack;
+extern char* __brkval;
+
+namespace {
+
+constexpr uint8_t STACK_PAINT = 0xc5;
+
+// Runs before the C runtime is set up (in .init1), so it must not use the
+// stack or assume that r1 is zero.
+__attribute__((naked, used, section(".init1"))) void paintStack() {
+  __asm volatile(
+    "    ldi r30, lo8(_end)\n"
+    "    ldi r31, hi8(_end)\n"
+    "    ldi r24, %0\n"
+    "    ldi r25, hi8(__stack)\n"
+    "    rjmp 2f\n"
+    "1:\n"
+    "    st Z+, r24\n"
+    "2:\n"
+    "    cpi r30, lo8(__stack)\n"
+    "    cpc r31, r25\n"
+    "    brlo 1b\n"
+    "    breq 1b\n"
+    :: "i" (STACK_PAINT));
+}
+
+}
+
+uint16_t unusedStackBytes() {
+  // The heap grows from the end of the static data towards the stack
+  const uint8_t* address = __brkval ? reinterpret_cast<const uint8_t*>(__brkval) : &_end;
+  uint16_t unused = 0;
+  while (address <= &__stack && *address == STACK_PAINT) {
+    address++;
+    unused++;
+  }
+  return unused;
+}
+
+#endif // ARDUINO_ARCH_ESP32
@@ -0,0 +1,221 @@
+#include "sync.hpp"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(SIMULATOR)
+
+namespace {
+
+enum PacketType : uint8_t {
+  TIME_REQUEST = 1,
+  TIME_RESPONSE = 2,
+  START = 3,
+};
+
+constexpr uint8_t VERSION = 1;
+constexpr uint8_t HEADER_SIZE = 4;
+constexpr uint8_t MAXIMUM_PACKET_SIZE = HEADER_SIZE + 16;
+
+void writeHeader(uint8_t* packet, PacketType type) {
+  packet[0] = 'R';
+  packet[1] = 'W';
+  packet[2] = VERSION;
+  packet[3] = type;
+}
+
+void writeNumber(uint8_t* data, uint64_t value, uint8_t size) {
+  for (uint8_t i = 0; i < size; i++) {
+    data[i] = value >> (i * 8);
+  }
+}
+
+uint64_t readNumber(const uint8_t* data, uint8_t size) {
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < size; i++) {
+    value |= (uint64_t)data[i] << (i * 8);
+  }
+  return value;
+}
+
+const IPAddress broadcast(255, 255, 255, 255);
+
+}
+
+namespace Ferriswheel
+{
+
+void WheelSync::begin() {
+  _udp.begin(Config::SYNC_PORT);
+}
+
+void WheelSync::setRole(Role role) {
+  portENTER_CRITICAL(&_lock);
+  _role = role;
+  _offsetKnown = false;
+  _startReceived = false;
+  _startAnnounced = false;
+  portEXIT_CRITICAL(&_lock);
+  _sampleCount = 0;
+}
+
+void WheelSync::loop() {
+  if (_role == Role::Off) {
+    return;
+  }
+  receive();
+
+  uint8_t packet[MAXIMUM_PACKET_SIZE];
+  const uint32_t nowMs = millis();
+  if (_role == Role::Follower && nowMs - _lastRequestMs >= REQUEST_INTERVAL_MS) {
+    _lastRequestMs = nowMs;
+    writeHeader(packet, TIME_REQUEST);
+    writeNumber(packet + HEADER_SIZE, esp_timer_get_time(), 8);
+    _udp.beginPacket(broadcast, Config::SYNC_PORT);
+    _udp.write(packet, HEADER_SIZE + 8);
+    _udp.endPacket();
+  }
+
+  if (_role == Role::Leader && nowMs - _lastAnnounceMs >= 20) {
+    portENTER_CRITICAL(&_lock);
+    const bool announced = _startAnnounced && _start.startUs > esp_timer_get_time();
+    _startAnnounced = announced;
+    const Start start = _start;
+    portEXIT_CRITICAL(&_lock);
+    if (announced) {
+      _lastAnnounceMs = nowMs;
+      writeHeader(packet, START);
+      packet[HEADER_SIZE] = start.animation;
+      packet[HEADER_SIZE + 1] = start.animationCount;
+      writeNumber(packet + HEADER_SIZE + 2, start.seed, 4);
+      writeNumber(packet + HEADER_SIZE + 6, start.startUs, 8);
+      _udp.beginPacket(broadcast, Config::SYNC_PORT);
+      _udp.write(packet, HEADER_SIZE + 14);
+      _udp.endPacket();
+    }
+  }
+}
+
+void WheelSync::receive() {
+  uint8_t packet[MAXIMUM_PACKET_SIZE];
+  while (_udp.parsePacket() > 0) {
+    const int size = _udp.read(packet, sizeof(packet));
+    if (size < HEADER_SIZE || packet[0] != 'R' || packet[1] != 'W' || packet[2] != VERSION) {
+      continue;
+    }
+    const uint8_t* const body = packet + HEADER_SIZE;
+    switch (packet[3]) {
+    case TIME_REQUEST:
+      if (_role == Role::Leader && size >= HEADER_SIZE + 8) {
+        // The request time is returned, so the follower does not need to remember it
+        uint8_t response[HEADER_SIZE + 16];
+        writeHeader(response, TIME_RESPONSE);
+        memcpy(response + HEADER_SIZE, body, 8);
+        writeNumber(response + HEADER_SIZE + 8, esp_timer_get_time(), 8);
+        _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+        _udp.write(response, sizeof(response));
+        _udp.endPacket();
+      }
+      break;
+    case TIME_RESPONSE:
+      if (_role == Role::Follower && size >= HEADER_SIZE + 16) {
+        addSample(readNumber(body, 8), readNumber(body + 8, 8), esp_timer_get_time());
+      }
+      break;
+    case START:
+      if (_role == Role::Follower && size >= HEADER_SIZE + 14) {
+        Start start;
+        start.animation = body[0];
+        start.animationCount = body[1];
+        start.seed = readNumber(body + 2, 4);
+        start.startUs = readNumber(body + 6, 8);
+        if (start.startUs != _lastStartUs) {
+          _lastStartUs = start.startUs;
+          portENTER_CRITICAL(&_lock);
+          _start = start;
+          _startReceived = true;
+          portEXIT_CRITICAL(&_lock);
+        }
+      }
+      break;
+    }
+  }
+}
+
+void WheelSync::addSample(int64_t requestUs, int64_t leaderUs, int64_t responseUs) {
+  const int64_t roundTripUs = responseUs - requestUs;
+  if (roundTripUs < 0 || roundTripUs > MAXIMUM_ROUND_TRIP_US) {
+    return;
+  }
+  // The leader answered on average in the middle of the round trip
+  _samples[_nextSample] = { leaderUs - (requestUs + responseUs) / 2, (uint32_t)roundTripUs };
+  _nextSample = (_nextSample + 1) % SAMPLES;
+  if (_sampleCount < SAMPLES) {
+    _sampleCount++;
+  }
+
+  const Sample* best = &_samples[0];
+  for (uint8_t i = 1; i < _sampleCount; i++) {
+    if (_samples[i].roundTripUs < best->roundTripUs) {
+      best = &_samples[i];
+    }
+  }
+  portENTER_CRITICAL(&_lock);
+  _offsetUs = best->offsetUs;
+  _offsetKnown = true;
+  _lastResponseMs = millis();
+  portEXIT_CRITICAL(&_lock);
+}
+
+int64_t WheelSync::now() {
+  if (_role != Role::Follower) {
+    return esp_timer_get_time();
+  }
+  portENTER_CRITICAL(&_lock);
+  const int64_t offsetUs = _offsetUs;
+  portEXIT_CRITICAL(&_lock);
+  return esp_timer_get_time() + offsetUs;
+}
+
+bool WheelSync::synchronized() {
+  switch (_role) {
+  case Role::Leader:
+    return true;
+  case Role::Follower:
+    return leaderAvailable();
+  default:
+    return false;
+  }
+}
+
+bool WheelSync::leaderAvailable() {
+  portENTER_CRITICAL(&_lock);
+  const bool available = _offsetKnown && millis() - _lastResponseMs < LEADER_TIMEOUT_MS;
+  portEXIT_CRITICAL(&_lock);
+  return available;
+}
+
+void WheelSync::announce(const Start& start) {
+  portENTER_CRITICAL(&_lock);
+  _start = start;
+  _startAnnounced = true;
+  portEXIT_CRITICAL(&_lock);
+  _lastAnnounceMs = 0;
+}
+
+bool WheelSync::startPending() {
+  portENTER_CRITICAL(&_lock);
+  const bool pending = _startReceived;
+  portEXIT_CRITICAL(&_lock);
+  return pending;
+}
+
+bool WheelSync::takeStart(Start& start) {
+  portENTER_CRITICAL(&_lock);
+  const bool pending = _startReceived;
+  start = _start;
+  _startReceived = false;
+  portEXIT_CRITICAL(&_lock);
+  return pending;
+}
+
+};
+
+#endif // ARDUINO_ARCH_ESP32 || SIMULATOR
@@ -0,0 +1,77 @@
+#include "transition.hpp"
+
+#ifdef TRANSITIONS_AVAILABLE
+
+void Transition::begin(Animation* outgoing) {
+  if (!_enabled || outgoing == nullptr) {
+    return;
+  }
+  memcpy(_from, leds, sizeof(_from));
+  _outgoing = outgoing;
+  _frame = 0;
+  _style = static_cast<Style>(randomBelow(3));
+}
+
+bool Transition::frame(Animation& incoming) {
+  // The incoming animation has been started on the LEDs directly
+  if (_frame == 0) {
+    memcpy(_to, leds, sizeof(_to));
+  }
+
+  if (!_outgoing->finished()) {
+    memcpy(leds, _from, sizeof(_from));
+    _outgoing->frame();
+    memcpy(_from, leds, sizeof(_from));
+  }
+  memcpy(leds, _to, sizeof(_to));
+  incoming.frame();
+  memcpy(_to, leds, sizeof(_to));
+
+  _frame++;
+  if (_frame >= FRAMES) {
+    // The LEDs already contain the incoming animation only
+    _outgoing = nullptr;
+    return true;
+  }
+
+  const uint16_t amount = (uint16_t)_frame * 256 / FRAMES;
+  switch (_style) {
+  case Style::Crossfade:
+    blendFrames(_from, _to, leds, amount);
+    break;
+  case Style::Wipe:
+    wipe(amount);
+    break;
+  case Style::Dissolve:
+    dissolve(amount);
+    break;
+  }
+  return true;
+}
+
+void Transition::cancel() {
+  if (active() && _frame > 0) {
+    memcpy(leds, _to, sizeof(_to));
+  }
+  _outgoing = nullptr;
+}
+
+void Transition::wipe(uint16_t amount) {
+  const uint16_t position = amount * NUM_LEDS;
+  const uint8_t edge = position >> 8;
+  memcpy(leds, _to, sizeof(CRGB) * edge);
+  memcpy(&leds[edge], &_from[edge], sizeof(CRGB) * (NUM_LEDS - edge));
+  if (edge < NUM_LEDS) {
+    leds[edge] = blend(_from[edge], _to[edge], position & 0xff);
+  }
+}
+
+void Transition::dissolve(uint16_t amount) {
+  for (uint8_t led = 0; led < NUM_LEDS; led++) {
+    // Multiplying with an odd number gives every LED a different threshold
+    const uint8_t threshold = led * 167 + 13;
+    leds[led] = threshold < amount ? _to[led] : _from[led];
+  }
+}
+
+#endif // TRANSITIONS_AVAILABLE
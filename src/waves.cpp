@@ -0,0 +1,206 @@
+#include "waves.hpp"
+
+#include "tables.hpp"
+
+namespace {
+
+// Angle from one entry of the sine table to the next
+constexpr double SINE_STEP = 3.14159265358979 / 128;
+
+// Taylor series of sin(x), the terms up to x^21 are exact to 8 bit for the
+// first quadrant
+constexpr double taylorSine(double x, double term, uint8_t power = 1) {
+  return power > 21 ? 0 : term + taylorSine(x, -term * x * x / ((power + 1) * (power + 2)), power + 2);
+}
+
+// The first quadrant of a sine with an amplitude of 127, the others mirror it
+struct QuarterSine {
+  typedef uint8_t type;
+  static constexpr uint16_t size = 65;
+  static constexpr uint8_t value(uint16_t index) { return 127 * taylorSine(index * SINE_STEP, index * SINE_STEP) + 0.5; }
+};
+
+// Smoothstep 3x^2 - 2x^3, rounded
+struct Smoothstep {
+  typedef uint8_t type;
+  static constexpr uint16_t size = 256;
+  static constexpr uint8_t value(uint16_t index) { return ((uint32_t)index * index * (3 * 255 - 2 * index) + 255 * 255 / 2) / (255 * 255); }
+};
+
+constexpr uint32_t mix(uint32_t value) {
+  return value ^ value >> 16;
+}
+
+// Random values at the whole positions of the noise
+struct NoiseLattice {
+  typedef uint8_t type;
+  static constexpr uint16_t size = 256;
+  static constexpr uint8_t value(uint16_t index) { return mix(mix((index + 1) * 0x9e3779b1UL) * 0x85ebca6bUL) >> 24; }
+};
+
+typedef Table<QuarterSine> Sine;
+typedef Table<Smoothstep> Ease;
+typedef Table<NoiseLattice> Lattice;
+
+static_assert(QuarterSine::value(0) == 0 && QuarterSine::value(64) == 127, "The sine table must reach the amplitude");
+static_assert(Smoothstep::value(0) == 0 && Smoothstep::value(255) == 255, "The easing table must cover the full range");
+
+// 128 + 127 * sin(phase / 256 * 2 PI)
+inline uint8_t sine(uint8_t phase) {
+  uint8_t index = phase & 0x3f;
+  if (phase & 0x40) {
+    index = 0x40 - index;
+  }
+  const uint8_t value = pgm_read_byte(&Sine::values[index]);
+  return phase & 0x80 ? 0x80 - value : 0x80 + value;
+}
+
+// Starts and ends slowly
+inline uint8_t ease(uint8_t progress) {
+  return pgm_read_byte(&Ease::values[progress]);
+}
+
+// Starts fast and ends slowly, the second half of ease()
+inline uint8_t easeOut(uint8_t progress) {
+  return (ease(0x80 + (progress >> 1)) - 0x80) * 2;
+}
+
+// Value noise: the lattice values are eased into each other, a new random
+// value is reached every 256 positions
+inline uint8_t noise(uint16_t position) {
+  const uint8_t cell = position >> 8;
+  return blend8(pgm_read_byte(&Lattice::values[cell]), pgm_read_byte(&Lattice::values[(uint8_t)(cell + 1)]), ease(position));
+}
+
+}
+
+WavingColors::WavingColors()
+    : FrameAnimation(framesPerMs<30>()), _first(getRandomColor()), _second(getRandomColor()), _drift(randomWord()) {
+  while (_second == _first) {
+    _second = getRandomColor();
+  }
+  // One to three periods of the long wave and three to six of the short one
+  _wavelengths[0] = 0x10000UL * randomBetween(1, 4) / ledCount();
+  _wavelengths[1] = 0x10000UL * randomBetween(3, 7) / ledCount();
+  // A period passes in about 3 to 10 seconds
+  _speeds[0] = 0x100 + randomBelow16(0x200);
+  _speeds[1] = -0x100 - randomBelow16(0x200);
+}
+
+void WavingColors::step() {
+  uint8_t level = 0xff;
+  const uint16_t remaining = duration - _step;
+  if (_step < fadeSteps) {
+    level = ease(_step * (0x100 / fadeSteps));
+  } else if (remaining <= fadeSteps) {
+    level = ease(remaining * (0x100 / fadeSteps) - 1);
+  }
+  CRGB first = _first;
+  CRGB second = _second;
+  first.nscale8(level);
+  second.nscale8(level);
+
+  uint16_t longPhase = _phases[0];
+  uint16_t shortPhase = _phases[1];
+  CRGB* const strip = firstLed();
+  for (uint8_t led = 0; led < ledCount(); led++) {
+    const uint8_t amount = (sine(longPhase >> 8) + sine(shortPhase >> 8)) >> 1;
+    strip[led] = blend(first, second, amount);
+    longPhase += _wavelengths[0];
+    shortPhase += _wavelengths[1];
+  }
+
+  // The noise changes the speed between half and one and a half times
+  const int16_t variation = 0x80 + noise(_drift);
+  for (uint8_t wave = 0; wave < 2; wave++) {
+    _phases[wave] += (int32_t)_speeds[wave] * variation / 0x100;
+  }
+  _drift += 0x08;
+  _step++;
+}
+
+ShootingStars::ShootingStars() : FrameAnimation(framesPerMs<20>()), _time(randomWord()) {
+  for (uint8_t star = 0; star < maxStars; star++) {
+    _stars[star].speed = 0;
+  }
+}
+
+bool ShootingStars::active() const {
+  for (uint8_t star = 0; star < maxStars; star++) {
+    if (_stars[star].speed > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ShootingStars::launch(Star& star) {
+  star.start = randomBelow(ledCount());
+  star.distance = randomBetween(12, 40);
+  star.progress = 0;
+  // Burns for 16 to 42 steps
+  star.speed = randomBetween(6, 16);
+  star.reverse = randomBool();
+}
+
+void ShootingStars::step() {
+  if (_remaining > 0) {
+    _fade = qadd8(_fade, 4);
+  } else if (!active()) {
+    _fade = qsub8(_fade, 4);
+  }
+  drawSky();
+
+  for (uint8_t index = 0; index < maxStars; index++) {
+    Star& star = _stars[index];
+    if (star.speed == 0) {
+      if (_remaining > 0 && _fade == 0xff && randomByte() < 3) {
+        launch(star);
+        _remaining--;
+      }
+      continue;
+    }
+    drawStar(star);
+    if (star.progress > 0xff - star.speed) {
+      star.speed = 0;
+    } else {
+      star.progress += star.speed;
+    }
+  }
+  _time += 0x10;
+}
+
+void ShootingStars::drawSky() {
+  // Neighbours are 13 cells of the noise apart, so every LED twinkles on its
+  // own. Only the upper part of the noise lights up.
+  uint16_t position = _time;
+  CRGB* const strip = firstLed();
+  for (uint8_t led = 0; led < ledCount(); led++) {
+    const uint8_t level = scale8(qsub8(noise(position), 0x90), _fade);
+    strip[led] = CRGB(level >> 3, level >> 2, level >> 1);
+    position += 0x0d00;
+  }
+}
+
+void ShootingStars::drawStar(const Star& star) {
+  static_assert(tailLength == 8, "The tail is scaled with a shift");
+  const uint8_t brightness = 0xff - ease(star.progress);
+  // Position of the head in 1/256 LEDs from the start
+  const uint16_t head = (uint16_t)easeOut(star.progress) * star.distance;
+  const uint8_t headLed = head >> 8;
+  const uint8_t fraction = head;
+
+  // The LED in front gets the part of the head which already reached it
+  CRGB* led = getLedOffset(star.start, headLed + 1, star.reverse);
+  const uint8_t front = scale8(brightness, fraction);
+  *led += CRGB(front, front, front);
+
+  // The tail fades linearly over tailLength LEDs behind the head
+  uint16_t remaining = tailLength * 0x100 - fraction;
+  for (uint8_t behind = 0; behind <= headLed && behind < tailLength; behind++) {
+    const uint8_t level = scale8(brightness, (remaining - 1) >> 3);
+    led = getLedOffset(star.start, headLed - behind, star.reverse);
+    *led += CRGB(level, level, level);
+    remaining -= 0x100;
+  }
+}
@@ -0,0 +1,40 @@
+#include "zone.hpp"
+
+#ifdef ZONES_AVAILABLE
+
+void Zone::begin(const LedSpan& span) {
+  _span = span;
+  _running = false;
+}
+
+bool Zone::advance() {
+  if (_running && _idleFrames > 0) {
+    _idleFrames--;
+    return false;
+  }
+  return true;
+}
+
+void Zone::start() {
+  Animation* animation = _buffer.get();
+  if (animation->clearOnStart()) {
+    allBlack();
+  }
+  animation->start();
+  _idleFrames = 0;
+  _running = true;
+}
+
+bool Zone::frame() {
+  Animation* animation = _buffer.get();
+  const bool changed = animation->frame();
+  // The frames until the next step would not change anything, a finished
+  // animation is replaced with the next tick
+  if (!animation->finished()) {
+    _idleFrames = animation->idleFrames();
+    animation->skipFrames(_idleFrames);
+  }
+  return changed;
+}
+
+#endif // ZONES_AVAILABLE
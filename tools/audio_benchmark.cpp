@@ -0,0 +1,117 @@
+// Feeds a WAV file (16 bit PCM, 16 kHz) through the AudioAnalyzer of the music
+// animations and measures how long each block takes on the host:
+//
+//   g++ -O2 -std=gnu++11 -Iinclude tools/audio_benchmark.cpp src/audioanalyzer.cpp -o audio_benchmark
+//   ./audio_benchmark music.wav [--quiet]
+//
+// Every block prints its time, the band levels and a B for a detected beat.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "audioanalyzer.hpp"
+
+namespace {
+
+uint32_t readLittleEndian(const uint8_t* data, uint8_t size) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < size; i++) {
+    value |= (uint32_t)data[i] << (i * 8);
+  }
+  return value;
+}
+
+// Returns the samples of the first channel
+bool readWav(const char* path, std::vector<int16_t>& samples) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    fprintf(stderr, "%s: cannot be opened\n", path);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[4096];
+  size_t size;
+  while ((size = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + size);
+  }
+  fclose(file);
+
+  if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0) {
+    fprintf(stderr, "%s: not a WAV file\n", path);
+    return false;
+  }
+  uint16_t channels = 0;
+  for (size_t offset = 12; offset + 8 <= data.size();) {
+    const uint32_t chunkSize = readLittleEndian(&data[offset + 4], 4);
+    const uint8_t* const body = &data[offset + 8];
+    if (offset + 8 + chunkSize > data.size()) {
+      break;
+    }
+    if (memcmp(&data[offset], "fmt ", 4) == 0) {
+      const uint16_t format = readLittleEndian(body, 2);
+      channels = readLittleEndian(body + 2, 2);
+      const uint32_t rate = readLittleEndian(body + 4, 4);
+      const uint16_t bits = readLittleEndian(body + 14, 2);
+      if (format != 1 || bits != 16 || rate != AudioAnalyzer::SAMPLE_RATE || channels == 0) {
+        fprintf(stderr, "%s: must be 16 bit PCM with %u Hz\n", path, AudioAnalyzer::SAMPLE_RATE);
+        return false;
+      }
+    } else if (memcmp(&data[offset], "data", 4) == 0 && channels > 0) {
+      for (uint32_t sample = 0; sample + channels * 2 <= chunkSize; sample += channels * 2) {
+        samples.push_back((int16_t)readLittleEndian(body + sample, 2));
+      }
+      return true;
+    }
+    offset += 8 + chunkSize + (chunkSize & 1);
+  }
+  fprintf(stderr, "%s: no samples found\n", path);
+  return false;
+}
+
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <file.wav> [--quiet]\n", argv[0]);
+    return 1;
+  }
+  const bool quiet = argc > 2 && strcmp(argv[2], "--quiet") == 0;
+  std::vector<int16_t> samples;
+  if (!readWav(argv[1], samples)) {
+    return 1;
+  }
+
+  AudioAnalyzer analyzer;
+  AudioAnalyzer::Result result;
+  uint32_t blocks = 0;
+  uint32_t beats = 0;
+  double totalUs = 0;
+  double maximumUs = 0;
+  for (size_t offset = 0; offset + AudioAnalyzer::SIZE <= samples.size(); offset += AudioAnalyzer::SIZE) {
+    const auto start = std::chrono::steady_clock::now();
+    analyzer.process(&samples[offset], result);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    totalUs += us;
+    maximumUs = us > maximumUs ? us : maximumUs;
+    blocks++;
+    beats += result.beat;
+
+    if (!quiet) {
+      printf("%8.3f s ", (double)offset / AudioAnalyzer::SAMPLE_RATE);
+      for (uint8_t band = 0; band < AudioAnalyzer::BANDS; band++) {
+        printf(" %3u", result.bands[band]);
+      }
+      printf("%s\n", result.beat ? "  B" : "");
+    }
+  }
+  if (blocks == 0) {
+    fprintf(stderr, "Less than one block of samples\n");
+    return 1;
+  }
+
+  const double blockUs = 1e6 * AudioAnalyzer::SIZE / AudioAnalyzer::SAMPLE_RATE;
+  printf("%u blocks, %u beats, %.2f us average, %.2f us maximum per block (%.0fx real time)\n",
+         blocks, beats, totalUs / blocks, maximumUs, blockUs * blocks / totalUs);
+  return 0;
+}
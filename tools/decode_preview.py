@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Decodes the live preview frames published by the ESP32.
+
+The input contains one or more encoded frames, for example received with
+`mosquitto_sub -N -t riesenrad/<unique id>/preview > preview.bin`. Every frame
+is printed as a row of colored blocks, or with --rgb as the bucket colors.
+"""
+
+import argparse
+import sys
+
+# Must match the palette in src/preview.cpp
+PALETTE = [
+    (0x00, 0x00, 0x00), (0xFF, 0x00, 0x00), (0xFF, 0xFF, 0x00), (0x00, 0x80, 0x00),
+    (0xFF, 0xFF, 0xF0), (0x00, 0x00, 0xFF), (0x00, 0xFF, 0xFF), (0xFF, 0x00, 0xFF),
+    (0xFF, 0xA5, 0x00), (0xFF, 0xFF, 0xFF), (0x80, 0x00, 0x80), (0xFF, 0xC0, 0xCB),
+    (0x80, 0x00, 0x00), (0x00, 0x64, 0x00), (0x00, 0x00, 0x80), (0x80, 0x80, 0x80),
+]
+
+
+def decode(data):
+    """Yields the bucket colors of every frame."""
+    offset = 0
+    while offset < len(data):
+        bucket_count = data[offset]
+        offset += 1
+        if bucket_count == 0:
+            sys.exit(f"Invalid frame at byte {offset - 1}")
+        buckets = []
+        while len(buckets) < bucket_count:
+            if offset >= len(data):
+                sys.exit("Truncated frame")
+            run = data[offset]
+            offset += 1
+            buckets.extend([PALETTE[run & 0x0F]] * ((run >> 4) + 1))
+        if len(buckets) != bucket_count:
+            sys.exit(f"Run exceeds the {bucket_count} buckets of the frame")
+        yield buckets
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="encoded frames (default: stdin)")
+    parser.add_argument("--rgb", action="store_true", help="print the colors as hex instead of blocks")
+    arguments = parser.parse_args()
+
+    if arguments.input:
+        with open(arguments.input, "rb") as encoded:
+            data = encoded.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    for buckets in decode(data):
+        if arguments.rgb:
+            print(" ".join(f"{r:02x}{g:02x}{b:02x}" for r, g, b in buckets))
+        else:
+            print("".join(f"\x1b[48;2;{r};{g};{b}m  " for r, g, b in buckets) + "\x1b[0m")
+
+
+if __name__ == "__main__":
+    main()
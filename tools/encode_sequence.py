@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Encodes recorded frames into the sequence format played by SequenceAnimation.
+
+The input is a raw dump of frames, each frame being the RGB bytes of all LEDs
+(like a copy of leds[]). The output is either a C++ header with the sequence
+stored in PROGMEM or a binary file, which can be concatenated with other
+sequences and written into the "sequences" partition of an ESP32.
+"""
+
+import argparse
+import struct
+import sys
+
+VERSION = 1
+MAX_RUN = 64
+# DynamicFrameAnimation can wait at most 254 frames of 10 ms
+MAX_DELAY_MS = 2540
+
+SKIP = 0x00
+FILL = 0x40
+LITERAL = 0x80
+HOLD = 0xC0
+
+
+def read_frames(path, led_count):
+    frame_size = led_count * 3
+    with open(path, "rb") as dump:
+        data = dump.read()
+    if len(data) % frame_size != 0:
+        sys.exit(f"{path}: size is not a multiple of {frame_size} bytes")
+    return [
+        [tuple(data[offset + led * 3:offset + led * 3 + 3]) for led in range(led_count)]
+        for offset in range(0, len(data), frame_size)
+    ]
+
+
+def run_length(frame, start, predicate):
+    length = 0
+    while start + length < len(frame) and length < MAX_RUN and predicate(start + length):
+        length += 1
+    return length
+
+
+def encode_frame(frame, previous):
+    encoded = bytearray()
+    led = 0
+    while led < len(frame):
+        if previous is not None and frame[led] == previous[led]:
+            length = run_length(frame, led, lambda i: frame[i] == previous[i])
+            encoded.append(SKIP | (length - 1))
+            led += length
+            continue
+
+        length = run_length(frame, led, lambda i: frame[i] == frame[led])
+        if length >= 2:
+            encoded.append(FILL | (length - 1))
+            encoded.extend(frame[led])
+            led += length
+            continue
+
+        # Collect colors until a skip or fill run would be cheaper
+        def literal(i):
+            if previous is not None and frame[i] == previous[i]:
+                return False
+            return i + 1 >= len(frame) or frame[i] != frame[i + 1]
+        length = max(1, run_length(frame, led, literal))
+        encoded.append(LITERAL | (length - 1))
+        for color in frame[led:led + length]:
+            encoded.extend(color)
+        led += length
+    return encoded
+
+
+def encode(frames, frame_ms, keyframe_interval):
+    body = bytearray()
+    frame_count = 0
+    previous = None
+    hold_offset = None
+    for index, frame in enumerate(frames):
+        keyframe = previous is None or (keyframe_interval > 0 and index % keyframe_interval == 0)
+        if not keyframe and frame == previous:
+            # Extend the previous hold, as long as it can still be waited for
+            if hold_offset is not None:
+                length = (body[hold_offset] & 0x3F) + 2
+                if length <= MAX_RUN and length * frame_ms <= MAX_DELAY_MS:
+                    body[hold_offset] = HOLD | (length - 1)
+                    continue
+            hold_offset = len(body)
+            body.append(HOLD)
+        else:
+            hold_offset = None
+            body.extend(encode_frame(frame, None if keyframe else previous))
+        frame_count += 1
+        previous = frame
+    header = b"RS" + struct.pack("<BBHHI", VERSION, len(frames[0]), frame_ms, frame_count, len(body))
+    return header + body
+
+
+def write_header(path, name, sequence):
+    with open(path, "w") as output:
+        output.write("#pragma once\n\n")
+        output.write("#include <Arduino.h>\n\n")
+        output.write("// Generated by tools/encode_sequence.py\n")
+        output.write(f"static const uint8_t {name}[] PROGMEM = {{\n")
+        for offset in range(0, len(sequence), 16):
+            line = ", ".join(f"0x{value:02x}" for value in sequence[offset:offset + 16])
+            output.write(f"  {line},\n")
+        output.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="raw RGB frame dump")
+    parser.add_argument("output", help="output file, a .hpp/.h creates a C++ header")
+    parser.add_argument("--leds", type=int, default=99, help="number of LEDs per frame (default: 99)")
+    parser.add_argument("--frame-ms", type=int, default=50, help="time between two frames (default: 50)")
+    parser.add_argument("--keyframe-interval", type=int, default=0,
+                        help="encode every n-th frame as keyframe (default: only the first frame)")
+    parser.add_argument("--name", default="sequence", help="array name in the C++ header")
+    arguments = parser.parse_args()
+
+    if arguments.frame_ms < 10 or arguments.frame_ms > MAX_DELAY_MS:
+        sys.exit(f"--frame-ms must be between 10 and {MAX_DELAY_MS}")
+    frames = read_frames(arguments.input, arguments.leds)
+    if not frames:
+        sys.exit("No frames found")
+    if len(frames) > 0xFFFF:
+        sys.exit("Too many frames")
+
+    sequence = encode(frames, arguments.frame_ms, arguments.keyframe_interval)
+    if arguments.output.endswith((".h", ".hpp")):
+        write_header(arguments.output, arguments.name, sequence)
+    else:
+        with open(arguments.output, "wb") as output:
+            output.write(sequence)
+    raw_size = len(frames) * arguments.leds * 3
+    print(f"{len(frames)} frames, {raw_size} bytes raw, {len(sequence)} bytes encoded")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+// Executes the motor profile against a simulated motor on the LEDC and checks
+// the schedule, the ramps and how often the motor task wakes up:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -DMOTOR_AVAILABLE -Itools/simulator -Iinclude tools/motor_test.cpp
+//     src/motorprofile.cpp -o motor_test
+//   ./motor_test
+//
+// The motor is switched off during the second run and on again while it
+// stands. Returns 1 when a check failed.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "motor.hpp"
+#include "motorprofile.hpp"
+
+namespace {
+
+constexpr int64_t FRAME_US = 10000;
+constexpr int64_t CYCLE_US = (Config::ACCELERATION_SECONDS * 2 + Config::STOP_EVERY_N_SECONDS + Config::STOP_FOR_N_SECONDS) * 1000000LL;
+constexpr int64_t DURATION_US = 3 * CYCLE_US;
+// When the motor is switched off and on again
+constexpr int64_t DISABLE_US = CYCLE_US + 30 * 1000000LL;
+constexpr int64_t ENABLE_US = DISABLE_US + 20 * 1000000LL;
+
+struct Sample {
+  int64_t timeUs;
+  double duty;
+  double speed;
+  MotorProfile::State state;
+};
+
+struct Run {
+  std::vector<Sample> samples;
+  // Segments the motor task executed, it only wakes up when they end
+  uint32_t wakeups;
+};
+
+// Runs the profile like innerMotorLoop(): fades always complete, a segment
+// which keeps the duty ends early when the profile is interrupted
+Run execute(MotorProfile::Shape shape) {
+  SimulatedMotor motor({ 1.0, 300, 0x40 });
+  MotorProfile profile(shape);
+  Run run { {}, 0 };
+  int64_t pulseUs;
+  int64_t segmentEndUs = 0;
+  bool holding = false;
+  for (int64_t nowUs = 0; nowUs < DURATION_US; nowUs += FRAME_US) {
+    const bool enabled = nowUs < DISABLE_US || nowUs >= ENABLE_US;
+    if (holding && profile.interrupt(enabled)) {
+      segmentEndUs = nowUs;
+    }
+    while (segmentEndUs <= nowUs) {
+      motor.advance(segmentEndUs, pulseUs);
+      const MotorProfile::Segment segment = profile.next(enabled);
+      motor.fade(segmentEndUs, segment.duty, segment.fade ? segment.durationMs : 0);
+      run.wakeups++;
+      holding = !segment.fade;
+      if (segment.durationMs == MotorProfile::FOREVER) {
+        segmentEndUs = DURATION_US;
+        break;
+      }
+      segmentEndUs += (int64_t)segment.durationMs * 1000;
+    }
+    motor.advance(nowUs, pulseUs);
+    run.samples.push_back({ nowUs, motor.duty(nowUs), motor.speed(), profile.state() });
+  }
+  return run;
+}
+
+uint8_t failures = 0;
+
+void check(bool passed, const char* format, double value) {
+  printf("%s ", passed ? "PASS" : "FAIL");
+  printf(format, value);
+  printf("\n");
+  failures += passed ? 0 : 1;
+}
+
+// Seconds from the first sample in the state to the first one after it
+double duration(const Run& run, MotorProfile::State state, int64_t afterUs) {
+  int64_t startUs = -1;
+  for (const Sample& sample : run.samples) {
+    if (sample.timeUs < afterUs) {
+      continue;
+    }
+    if (startUs < 0 && sample.state == state) {
+      startUs = sample.timeUs;
+    } else if (startUs >= 0 && sample.state != state) {
+      return (sample.timeUs - startUs) / 1e6;
+    }
+  }
+  return -1;
+}
+
+// Seconds from the time until the state is reached
+double reaction(const Run& run, MotorProfile::State state, int64_t afterUs) {
+  for (const Sample& sample : run.samples) {
+    if (sample.timeUs >= afterUs && sample.state == state) {
+      return (sample.timeUs - afterUs) / 1e6;
+    }
+  }
+  return -1;
+}
+
+// Largest change of the duty between two frames, apart from the start of
+// the wheel at MIN_SPEED and the stop below it
+double largestStep(const Run& run) {
+  double largest = 0;
+  for (size_t i = 1; i < run.samples.size(); i++) {
+    const double from = run.samples[i - 1].duty;
+    const double to = run.samples[i].duty;
+    if (from == 0 || to == 0) {
+      continue;
+    }
+    largest = fmax(largest, fabs(to - from));
+  }
+  return largest;
+}
+
+// Largest change of the wheel's speed per second, relative to full speed
+double largestAcceleration(const Run& run) {
+  double largest = 0;
+  for (size_t i = 1; i < run.samples.size(); i++) {
+    largest = fmax(largest, fabs(run.samples[i].speed - run.samples[i - 1].speed) * 1e6 / FRAME_US);
+  }
+  return largest;
+}
+
+}
+
+int main() {
+  typedef MotorProfile::State State;
+  const Run linear = execute(MotorProfile::Shape::Linear);
+  const Run sCurve = execute(MotorProfile::Shape::SCurve);
+  const double rampSeconds = Config::ACCELERATION_SECONDS;
+  // A linear ramp of the duty changes this much per frame
+  const double linearStep = (double)(Config::MAX_SPEED - Config::MIN_SPEED) * FRAME_US / (rampSeconds * 1e6);
+
+  check(fabs(duration(sCurve, State::RampUp, 0) - rampSeconds) < 0.02, "ramp up takes %.2f s", duration(sCurve, State::RampUp, 0));
+  check(fabs(duration(sCurve, State::Running, 0) - Config::STOP_EVERY_N_SECONDS) < 0.02,
+        "runs for %.2f s", duration(sCurve, State::Running, 0));
+  check(fabs(duration(sCurve, State::RampDown, 0) - rampSeconds) < 0.02, "ramp down takes %.2f s", duration(sCurve, State::RampDown, 0));
+  check(fabs(duration(sCurve, State::Stopped, rampSeconds * 1e6) - Config::STOP_FOR_N_SECONDS) < 0.02,
+        "stops for %.2f s", duration(sCurve, State::Stopped, rampSeconds * 1e6));
+  check(reaction(sCurve, State::RampDown, DISABLE_US) <= 0.01, "switched off, ramps down after %.2f s", reaction(sCurve, State::RampDown, DISABLE_US));
+  check(reaction(sCurve, State::RampUp, ENABLE_US) <= 0.01, "switched on, ramps up after %.2f s", reaction(sCurve, State::RampUp, ENABLE_US));
+  check(largestStep(linear) <= linearStep * 1.01, "linear ramp changes the duty by at most %.2f per frame", largestStep(linear));
+  // The steepest part of the smoothstep is 1.5 times the linear slope
+  check(largestStep(sCurve) <= linearStep * 1.51, "S-curve ramp changes the duty by at most %.2f per frame", largestStep(sCurve));
+
+  // Stepping in software every 100 ms wakes up all the time
+  const uint32_t steppedWakeups = DURATION_US / 100000;
+  check(sCurve.wakeups * 50 < steppedWakeups, "the motor task woke up %.0f times", sCurve.wakeups);
+  printf("     stepping every 100 ms: %u wakeups, linear ramps: %u\n", steppedWakeups, linear.wakeups);
+  printf("     largest acceleration of the wheel: linear %.2f, S-curve %.2f of full speed per second\n",
+         largestAcceleration(linear), largestAcceleration(sCurve));
+  return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,78 @@
+// Measures the OutputStage of the controller on the host and checks that the
+// dithered frames average to the intended levels:
+//
+//   g++ -O2 -std=gnu++11 -DOUTPUT_STAGE_AVAILABLE -Iinclude tools/output_benchmark.cpp src/output.cpp
+//     -o output_benchmark
+//   ./output_benchmark
+//
+// Only the ESP32 renders the frames like this, its time is printed after
+// every animation ("Output rendered in"). The AVR boards do not have the RAM
+// for the output buffer and let FastLED scale the pixels while sending.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "config.hpp"
+#include "output.hpp"
+
+namespace {
+
+constexpr uint8_t LEDS = 99;
+constexpr uint16_t FRAMES = 256;
+
+uint16_t scaleOf(uint8_t brightness) {
+  return (uint32_t)brightness * Config::MAX_BRIGHTNESS * 0x101 / 0xff;
+}
+
+}
+
+int main() {
+  uint8_t frame[LEDS * 3];
+  uint8_t output[LEDS * 3];
+  for (uint16_t i = 0; i < sizeof(frame); i++) {
+    frame[i] = rand();
+  }
+
+  OutputStage stage;
+  stage.setScale(scaleOf(0xff));
+  const uint32_t repetitions = 20000;
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < repetitions; i++) {
+    stage.render(frame, output, LEDS, i % LEDS);
+  }
+  const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  printf("%.2f us per frame of %u LEDs\n", us / repetitions, LEDS);
+
+  // A dark fade of a single channel: the average over the frames must follow
+  // the 16 bit level instead of the 8 bit steps
+  double maximumError = 0;
+  uint16_t distinctLevels = 0;
+  double previous = -1;
+  for (uint16_t value = 0; value < 256; value++) {
+    for (uint8_t led = 0; led < LEDS; led++) {
+      frame[led * 3] = value;
+      frame[led * 3 + 1] = 0;
+      frame[led * 3 + 2] = 0;
+    }
+    stage.setScale(scaleOf(0x40));
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < FRAMES; i++) {
+      stage.render(frame, output, LEDS, 0);
+      sum += stage.sums().red;
+    }
+    const double average = (double)sum / FRAMES / LEDS;
+    const double expected = pow(value / 255.0, Config::GAMMA_CORRECTION ? 2.25 : 1.0) * 0xffff
+      * scaleOf(0x40) / 0x10000 * (uint8_t)(Config::COLOR_CORRECTION >> 16) / 0xff / 0x100;
+    if (fabs(average - expected) > maximumError) {
+      maximumError = fabs(average - expected);
+    }
+    if (average != previous) {
+      distinctLevels++;
+      previous = average;
+    }
+  }
+  printf("Fade at a quarter brightness: %u distinct levels, %.4f maximum error of the average\n",
+         distinctLevels, maximumError);
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Measures how far the angle MotorPhase estimates is from the one of a
+// simulated motor, which runs the motor profile for ten minutes:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -DMOTOR_AVAILABLE -Itools/simulator -Iinclude tools/phase_simulation.cpp
+//     src/motorphase.cpp src/motorprofile.cpp -o phase_simulation
+//   ./phase_simulation
+//
+// The error is sampled on every 10 ms frame and given in LEDs. The motors
+// differ from the model of MotorPhase in speed, delay and stall duty; the
+// index pulse is expected to correct the speed within a few revolutions.
+#include <cmath>
+#include <cstdio>
+
+#include "leds.hpp"
+#include "motor.hpp"
+#include "motorphase.hpp"
+#include "motorprofile.hpp"
+
+namespace {
+
+constexpr int64_t DURATION_US = 600 * 1000000LL;
+constexpr int64_t FRAME_US = 10000;
+
+struct Scenario {
+  const char* name;
+  SimulatedMotor::Model model;
+  bool indexPulse;
+};
+
+struct Errors {
+  double rms;
+  double maximum;
+  // Maximum over the second half, after the gain settled
+  double settled;
+  uint32_t pulses;
+};
+
+// Signed distance from the true angle in LEDs
+double ledError(uint32_t estimate, double revolutions) {
+  const uint32_t actual = (uint32_t)(uint64_t)((revolutions - floor(revolutions)) * MotorPhase::REVOLUTION);
+  return (double)(int32_t)(estimate - actual) * NUM_LEDS / MotorPhase::REVOLUTION;
+}
+
+Errors simulate(const Scenario& scenario) {
+  SimulatedMotor motor(scenario.model);
+  MotorPhase phase;
+  MotorProfile profile(Config::MOTOR_S_CURVE ? MotorProfile::Shape::SCurve : MotorProfile::Shape::Linear);
+  Errors errors { 0, 0, 0, 0 };
+  double squares = 0;
+  uint32_t frames = 0;
+  const auto advance = [&](int64_t timeUs) {
+    int64_t pulseUs;
+    if (motor.advance(timeUs, pulseUs) && scenario.indexPulse) {
+      // The interrupt records the time, the motor task applies it
+      phase.pulseDetected(pulseUs);
+      phase.indexPulse();
+      errors.pulses++;
+    }
+  };
+  int64_t segmentEndUs = 0;
+  for (int64_t nowUs = 0; nowUs < DURATION_US; nowUs += FRAME_US) {
+    // Like innerMotorLoop(), segments start when the previous one ended
+    while (segmentEndUs <= nowUs) {
+      advance(segmentEndUs);
+      const uint8_t previousDuty = profile.duty();
+      const MotorProfile::Segment segment = profile.next(true);
+      const uint32_t durationMs = segment.fade ? segment.durationMs : 0;
+      phase.segment(segmentEndUs, segment.fade ? previousDuty : segment.duty, segment.duty, durationMs);
+      motor.fade(segmentEndUs, segment.duty, durationMs);
+      segmentEndUs += (int64_t)segment.durationMs * 1000;
+    }
+    advance(nowUs);
+    const double error = fabs(ledError(phase.phaseAt(nowUs), motor.revolutions()));
+    squares += error * error;
+    frames++;
+    errors.maximum = fmax(errors.maximum, error);
+    if (nowUs >= DURATION_US / 2) {
+      errors.settled = fmax(errors.settled, error);
+    }
+  }
+  errors.rms = sqrt(squares / frames);
+  return errors;
+}
+
+}
+
+int main() {
+  static const Scenario scenarios[] = {
+    { "Model", { 1.0, 0, 0 }, false },
+    { "Delayed", { 1.0, 300, 0 }, false },
+    { "Delayed, index", { 1.0, 300, 0 }, true },
+    { "8% fast", { 1.08, 300, 0x40 }, false },
+    { "8% fast, index", { 1.08, 300, 0x40 }, true },
+    { "10% slow", { 0.9, 300, 0x40 }, false },
+    { "10% slow, index", { 0.9, 300, 0x40 }, true },
+  };
+  printf("%-18s %8s %8s %8s %7s  (LEDs)\n", "Motor", "RMS", "Maximum", "Settled", "Pulses");
+  for (const Scenario& scenario : scenarios) {
+    const Errors errors = simulate(scenario);
+    printf("%-18s %8.2f %8.2f %8.2f %7u\n", scenario.name, errors.rms, errors.maximum, errors.settled, errors.pulses);
+  }
+  return 0;
+}
@@ -0,0 +1,92 @@
+"""Prints the resources used by the firmware after it was linked.
+
+Registered as an extra script in platformio.ini, so every build of an
+environment reports:
+- sizeof() of every animation and the capacity of the AnimationBuffer
+- the size of the sections, summed up into RAM and flash
+- the largest symbols
+
+Build flags like MOTOR_AVAILABLE are taken from the environment, so building
+with PLATFORMIO_BUILD_FLAGS="-D MOTOR_AVAILABLE" reports that configuration.
+"""
+
+import os
+import re
+import subprocess
+
+Import("env", "projenv")  # noqa: F821 (provided by PlatformIO)
+
+LARGEST_SYMBOLS = 15
+
+# Sections which occupy RAM at runtime. .data is also stored in flash.
+RAM_SECTIONS = re.compile(r"^\.(data|bss|noinit|dram0\.\w+|iram0\.\w+)$")
+FLASH_SECTIONS = re.compile(r"^\.(text|data|rodata|flash\.\w+|iram0\.text)$")
+
+SIZE_VALUE = re.compile(
+    r"^_?(ResourceSize_\w+):\s*\n(?:\s*\.[a-z]+.*\n)*?\s*\.(?:word|short|2byte|hword|half|value)\s+(\d+)",
+    re.MULTILINE,
+)
+
+
+def tool(name):
+    # The size tool is known to PlatformIO, the other binutils are next to it
+    size_tool = env.subst("$SIZETOOL")  # noqa: F821
+    return size_tool[: -len("size")] + name
+
+
+def run(command):
+    return subprocess.run(command, check=True, capture_output=True, text=True, shell=isinstance(command, str)).stdout
+
+
+def report_animation_sizes():
+    source = os.path.join(env.subst("$PROJECT_DIR"), "tools", "resource_sizes.cpp")  # noqa: F821
+    output = os.path.join(env.subst("$BUILD_DIR"), "resource_sizes.s")  # noqa: F821
+    command = projenv.subst("$CXX -S -o") + f' "{output}" ' + projenv.subst("$CXXFLAGS $CCFLAGS $_CCCOMCOM") + f' "{source}"'  # noqa: F821
+    run(command)
+    with open(output) as assembly:
+        sizes = SIZE_VALUE.findall(assembly.read())
+    print("Object sizes (bytes):")
+    for name, value in sizes:
+        print(f"  {name[len('ResourceSize_'):]:<24} {int(value):>6}")
+
+
+def report_sections(elf):
+    ram = 0
+    flash = 0
+    print("Sections (bytes):")
+    for line in run([tool("size"), "-A", elf]).splitlines():
+        parts = line.split()
+        if len(parts) < 2 or not parts[0].startswith(".") or not parts[1].isdigit():
+            continue
+        name, size = parts[0], int(parts[1])
+        if size == 0:
+            continue
+        if RAM_SECTIONS.match(name):
+            ram += size
+        if FLASH_SECTIONS.match(name):
+            flash += size
+        print(f"  {name:<24} {size:>8}")
+    print(f"  {'RAM':<24} {ram:>8}")
+    print(f"  {'Flash':<24} {flash:>8}")
+
+
+def report_symbols(elf):
+    symbols = run([tool("nm"), "--size-sort", "--reverse-sort", "-C", "-S", elf]).splitlines()
+    print(f"Largest {LARGEST_SYMBOLS} symbols (bytes):")
+    for line in symbols[:LARGEST_SYMBOLS]:
+        _, size, kind, name = line.split(maxsplit=3)
+        print(f"  {int(size, 16):>8} {kind} {name}")
+
+
+def report(target, source, env):
+    elf = str(source[0])
+    print(f"Resource report for {env.subst('$PIOENV')} {env.subst('$BUILD_FLAGS')}".rstrip())
+    for step in (report_animation_sizes, lambda: report_sections(elf), lambda: report_symbols(elf)):
+        try:
+            step()
+        except (OSError, subprocess.CalledProcessError) as error:
+            # The report must never break a build
+            print(f"  Not available: {error}")
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", report)  # noqa: F821
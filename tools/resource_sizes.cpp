@@ -0,0 +1,15 @@
+// Compiled by resource_report.py with the flags of the environment, but not
+// linked. The values are read back from the generated assembly.
+#include "controller/controller.hpp"
+
+using namespace Ferriswheel;
+
+#define X(field) \
+  extern "C" const uint16_t ResourceSize_##field = sizeof(field);
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+
+extern "C" const uint16_t ResourceSize_AnimationBuffer = AnimationBuffer::capacity();
+extern "C" const uint16_t ResourceSize_Transition = sizeof(Transition);
+extern "C" const uint16_t ResourceSize_Interpolator = sizeof(Interpolator);
@@ -0,0 +1,163 @@
+// Compares the bytecode interpreter of ScriptAnimation with the native
+// animations it imitates, with the Arduino and FastLED parts of the simulator:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -Itools/simulator -Iinclude tools/script_benchmark.cpp
+//     src/script.cpp src/snake.cpp src/leds.cpp src/random.cpp src/animation.cpp -o script_benchmark
+//   ./script_benchmark [--verbose]
+//
+// The rotation script fills a gradient once and rotates it like
+// RotationAnimation, the snake script redraws every LED on every step like
+// SnakeAnimation. The host is much faster than an ESP32, so the ratios
+// between the animations are more meaningful than the absolute times.
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "animationbuffer.hpp"
+#include "rotation.hpp"
+#include "script.hpp"
+#include "snake.hpp"
+
+// Reports why a script stopped, with --verbose
+SimulatedSerial Serial;
+
+namespace {
+
+constexpr uint32_t STEPS = 20000;
+
+// Writes a program with forward jumps to labels
+class Assembler {
+public:
+  Assembler() : _code { 'R', 'B', Script::VERSION } {}
+
+  Assembler& op(Script::Opcode opcode) {
+    _code.push_back(opcode);
+    return *this;
+  }
+  Assembler& push8(uint8_t value) { return op(Script::PUSH8).byte(value); }
+  Assembler& push24(uint32_t value) { return op(Script::PUSH24).byte(value).byte(value >> 8).byte(value >> 16); }
+
+  // Jumps and FOR to a label which is placed later
+  Assembler& jump(Script::Opcode opcode, uint8_t label) {
+    op(opcode);
+    _fixups.push_back({ (uint16_t)_code.size(), label });
+    return byte(0).byte(0);
+  }
+  Assembler& label(uint8_t label) {
+    for (const Fixup& fixup : _fixups) {
+      if (fixup.label == label) {
+        _code[fixup.offset] = _code.size();
+        _code[fixup.offset + 1] = _code.size() >> 8;
+      }
+    }
+    return *this;
+  }
+
+  const std::vector<uint8_t>& code() const { return _code; }
+private:
+  struct Fixup {
+    uint16_t offset;
+    uint8_t label;
+  };
+
+  std::vector<uint8_t> _code;
+  std::vector<Fixup> _fixups;
+
+  Assembler& byte(uint8_t value) {
+    _code.push_back(value);
+    return *this;
+  }
+};
+
+std::vector<uint8_t> rotationScript() {
+  using namespace Script;
+  enum { ROTATE_ONLY };
+  Assembler program;
+  program.op(STEP).jump(JNZ, ROTATE_ONLY)
+    .push8(0).op(LEDS).push24(CRGB::SkyBlue).push24(CRGB::Blue).op(GRADIENT)
+    .label(ROTATE_ONLY)
+    .push8(1).op(ROTATE)
+    .push8(50).op(YIELD);
+  return program.code();
+}
+
+std::vector<uint8_t> snakeScript() {
+  using namespace Script;
+  enum { LOOP_END, BACKGROUND, NEXT_LED };
+  Assembler program;
+  program.op(LEDS).jump(FOR, LOOP_END)
+    // ( index ) the body covers 8 LEDs behind the moving head
+    .op(INDEX)
+    .op(INDEX).op(STEP).op(ADD).op(LEDS).op(MOD).push8(8).op(LT)
+    .jump(JZ, BACKGROUND)
+    .push24(CRGB::Green).op(SET).jump(JMP, NEXT_LED)
+    .label(BACKGROUND)
+    .push8(0).op(SET)
+    .label(NEXT_LED)
+    .op(NEXT)
+    .label(LOOP_END)
+    .push8(50).op(YIELD);
+  return program.code();
+}
+
+// Microseconds per step, finished animations are created again
+template<class Create>
+double measure(Create create) {
+  AnimationBuffer buffer;
+  create(buffer);
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < STEPS; i++) {
+    Animation* animation = buffer.get();
+    while (!animation->frame()) {
+      if (animation->finished()) {
+        create(buffer);
+        animation = buffer.get();
+      }
+    }
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / STEPS;
+}
+
+double measureScript(const std::vector<uint8_t>& code) {
+  if (!scriptProgram.upload(code.data(), code.size())) {
+    fprintf(stderr, "Invalid script\n");
+    return 0;
+  }
+  // Created like the controller does, a finished script is not created again
+  AnimationBuffer buffer;
+  buffer.create<ScriptAnimation>();
+  Animation& animation = *buffer.get();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < STEPS; i++) {
+    while (!animation.frame()) {
+    }
+  }
+  const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / STEPS;
+  if (animation.finished()) {
+    fprintf(stderr, "The script stopped, --verbose prints the reason\n");
+  }
+  return us;
+}
+
+void print(const char* name, double us, double nativeUs) {
+  printf("%-20s %7.3f us per step, %5.1fx the native animation\n", name, us, us / nativeUs);
+}
+
+}
+
+int main(int argc, char** argv) {
+  Serial.verbose = argc > 1 && strcmp(argv[1], "--verbose") == 0;
+  seedRandom(1);
+  const double rotationUs = measure([](AnimationBuffer& buffer) {
+    const uint32_t colors[] = { CRGB::SkyBlue, CRGB::Blue };
+    buffer.create<RotationAnimation>(colors, 1, false);
+  });
+  const double snakeUs = measure([](AnimationBuffer& buffer) { buffer.create<SnakeAnimation>(); });
+
+  print(RotationAnimation::NAME, rotationUs, rotationUs);
+  print("Rotation script", measureScript(rotationScript()), rotationUs);
+  print(SnakeAnimation::NAME, snakeUs, snakeUs);
+  print("Snake script", measureScript(snakeScript()), snakeUs);
+  return 0;
+}
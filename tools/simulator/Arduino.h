@@ -0,0 +1,78 @@
+#pragma once
+
+// The parts of the Arduino framework the animations and the controller use,
+// for the simulator on the host. Time only advances when the simulator moves
+// the virtual clock.
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+
+// Microseconds since the start of the simulation
+extern uint64_t simulatedMicros;
+
+inline uint32_t micros() { return (uint32_t)simulatedMicros; }
+inline uint32_t millis() { return (uint32_t)(simulatedMicros / 1000); }
+inline void delay(uint32_t ms) { simulatedMicros += (uint64_t)ms * 1000; }
+inline void delayMicroseconds(uint32_t us) { simulatedMicros += us; }
+inline int64_t esp_timer_get_time() { return simulatedMicros; }
+
+template<class A, class B>
+constexpr typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template<class A, class B>
+constexpr typename std::common_type<A, B>::type max(A a, B b) { return a > b ? a : b; }
+template<class T, class L, class H>
+constexpr T constrain(T value, L low, H high) { return value < low ? low : (value > high ? high : value); }
+
+inline long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+  return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+// Prints to stderr while verbose is set, otherwise the log is dropped
+class SimulatedSerial {
+public:
+  bool verbose { false };
+
+  void begin(uint32_t) {}
+
+  void print(const char* text) { write("%s", text); }
+  void print(char character) { write("%c", character); }
+  void print(int value) { write("%d", value); }
+  void print(unsigned int value) { write("%u", value); }
+  void print(long value) { write("%ld", value); }
+  void print(unsigned long value) { write("%lu", value); }
+  void print(double value) { write("%.2f", value); }
+
+  template<class T>
+  void println(T value) {
+    print(value);
+    println();
+  }
+  void println() { write("\n"); }
+
+  void printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    if (verbose) {
+      va_list arguments;
+      va_start(arguments, format);
+      vfprintf(stderr, format, arguments);
+      va_end(arguments);
+    }
+  }
+private:
+  template<class... Args>
+  void write(const char* format, Args... arguments) {
+    if (verbose) {
+      fprintf(stderr, format, arguments...);
+    }
+  }
+};
+
+extern SimulatedSerial Serial;
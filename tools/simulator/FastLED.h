@@ -0,0 +1,244 @@
+#pragma once
+
+// The parts of FastLED the animations and the controller use, for the
+// simulator on the host. The color math follows FastLED's portable C
+// versions, so the simulated frames match the ones of the boards.
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(uint8_t value, fract8 scale) {
+  return ((uint16_t)value * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t value, fract8 scale) {
+  return ((uint16_t)value * scale >> 8) + (value && scale ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t a, uint8_t b) {
+  const uint16_t sum = a + b;
+  return sum > 0xff ? 0xff : sum;
+}
+
+inline uint8_t qsub8(uint8_t a, uint8_t b) {
+  return a > b ? a - b : 0;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+  uint16_t partial = (a << 8) | b;
+  partial += b * amountOfB;
+  partial -= a * amountOfB;
+  return partial >> 8;
+}
+
+inline uint8_t sin8(uint8_t theta) {
+  static const uint8_t interleave[] = { 0, 49, 49, 41, 90, 27, 117, 10 };
+  uint8_t offset = theta;
+  if (theta & 0x40) {
+    offset = 0xff - offset;
+  }
+  offset &= 0x3f;
+  uint8_t secondaryOffset = offset & 0x0f;
+  if (theta & 0x40) {
+    secondaryOffset++;
+  }
+  const uint8_t* const section = &interleave[(offset >> 4) * 2];
+  int8_t y = ((section[1] * secondaryOffset) >> 4) + section[0];
+  if (theta & 0x80) {
+    y = -y;
+  }
+  return y + 128;
+}
+
+inline uint8_t cos8(uint8_t theta) {
+  return sin8(theta + 64);
+}
+
+struct CRGB {
+  union {
+    struct {
+      uint8_t r;
+      uint8_t g;
+      uint8_t b;
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode : uint32_t {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Cyan = 0x00FFFF,
+    DarkGreen = 0x006400,
+    Gray = 0x808080,
+    Green = 0x008000,
+    Ivory = 0xFFFFF0,
+    Magenta = 0xFF00FF,
+    Maroon = 0x800000,
+    Navy = 0x000080,
+    Orange = 0xFFA500,
+    Pink = 0xFFC0CB,
+    Purple = 0x800080,
+    Red = 0xFF0000,
+    RoyalBlue = 0x4169E1,
+    SkyBlue = 0x87CEEB,
+    Turquoise = 0x40E0D0,
+    Wheat = 0xF5DEB3,
+    White = 0xFFFFFF,
+    Yellow = 0xFFFF00,
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+  constexpr CRGB(uint32_t color) : r(color >> 16), g(color >> 8), b(color) {}
+  constexpr CRGB(HTMLColorCode color) : CRGB((uint32_t)color) {}
+  CRGB(const struct CHSV& hsv);
+
+  uint8_t& operator[](uint8_t index) { return raw[index]; }
+  const uint8_t& operator[](uint8_t index) const { return raw[index]; }
+
+  CRGB& nscale8(uint8_t scale) {
+    r = scale8(r, scale);
+    g = scale8(g, scale);
+    b = scale8(b, scale);
+    return *this;
+  }
+
+  CRGB& fadeToBlackBy(uint8_t amount) { return nscale8(0xff - amount); }
+
+  CRGB& operator+=(const CRGB& other) {
+    r = qadd8(r, other.r);
+    g = qadd8(g, other.g);
+    b = qadd8(b, other.b);
+    return *this;
+  }
+
+  explicit operator bool() const { return r || g || b; }
+};
+
+struct CHSV {
+  uint8_t h;
+  uint8_t s;
+  uint8_t v;
+
+  CHSV(uint8_t hue, uint8_t saturation, uint8_t value) : h(hue), s(saturation), v(value) {}
+};
+
+// hsv2rgb_rainbow(), the conversion FastLED uses for CHSV
+inline void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  const uint8_t offset8 = (hsv.h & 0x1f) << 3;
+  const uint8_t third = scale8(offset8, 256 / 3);
+  const uint8_t twoThirds = scale8(offset8, 256 * 2 / 3);
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+  switch (hsv.h >> 5) {
+  case 0: r = 255 - third; g = third; b = 0; break;
+  case 1: r = 171; g = 85 + third; b = 0; break;
+  case 2: r = 171 - twoThirds; g = 170 + third; b = 0; break;
+  case 3: r = 0; g = 255 - third; b = third; break;
+  case 4: r = 0; g = 171 - twoThirds; b = 85 + twoThirds; break;
+  case 5: r = third; g = 0; b = 255 - third; break;
+  case 6: r = 85 + third; g = 0; b = 171 - third; break;
+  default: r = 170 + third; g = 0; b = 85 - third; break;
+  }
+  if (hsv.s != 255) {
+    if (hsv.s == 0) {
+      r = g = b = 255;
+    } else {
+      const uint8_t desaturation = scale8_video(255 - hsv.s, 255 - hsv.s);
+      r = scale8(r, 255 - desaturation) + desaturation;
+      g = scale8(g, 255 - desaturation) + desaturation;
+      b = scale8(b, 255 - desaturation) + desaturation;
+    }
+  }
+  if (hsv.v != 255) {
+    const uint8_t value = scale8_video(hsv.v, hsv.v);
+    r = value ? scale8(r, value) : 0;
+    g = value ? scale8(g, value) : 0;
+    b = value ? scale8(b, value) : 0;
+  }
+  rgb = CRGB(r, g, b);
+}
+
+inline CRGB::CRGB(const CHSV& hsv) {
+  hsv2rgb_rainbow(hsv, *this);
+}
+
+inline bool operator==(const CRGB& a, const CRGB& b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+inline bool operator!=(const CRGB& a, const CRGB& b) { return !(a == b); }
+
+inline CRGB blend(const CRGB& a, const CRGB& b, fract8 amountOfB) {
+  return CRGB(blend8(a.r, b.r, amountOfB), blend8(a.g, b.g, amountOfB), blend8(a.b, b.b, amountOfB));
+}
+
+inline CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+  if (amountOfOverlay == 0xff) {
+    existing = overlay;
+  } else if (amountOfOverlay > 0) {
+    existing = blend(existing, overlay, amountOfOverlay);
+  }
+  return existing;
+}
+
+inline void fill_solid(CRGB* leds, int count, const CRGB& color) {
+  for (int i = 0; i < count; i++) {
+    leds[i] = color;
+  }
+}
+
+inline void fill_gradient_RGB(CRGB* leds, uint16_t start, CRGB startColor, uint16_t end, CRGB endColor) {
+  if (end < start) {
+    const uint16_t position = end;
+    end = start;
+    start = position;
+    const CRGB color = endColor;
+    endColor = startColor;
+    startColor = color;
+  }
+  const int16_t divisor = end - start ? end - start : 1;
+  int16_t deltas[3];
+  uint16_t values[3];
+  for (uint8_t channel = 0; channel < 3; channel++) {
+    deltas[channel] = (int16_t)((endColor[channel] - startColor[channel]) << 7) / divisor * 2;
+    values[channel] = startColor[channel] << 8;
+  }
+  for (uint16_t i = start; i <= end; i++) {
+    leds[i] = CRGB(values[0] >> 8, values[1] >> 8, values[2] >> 8);
+    for (uint8_t channel = 0; channel < 3; channel++) {
+      values[channel] += deltas[channel];
+    }
+  }
+}
+
+inline void fill_gradient_RGB(CRGB* leds, uint16_t count, const CRGB& startColor, const CRGB& endColor) {
+  fill_gradient_RGB(leds, 0, startColor, count - 1, endColor);
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t count, uint8_t amount) {
+  for (uint16_t i = 0; i < count; i++) {
+    leds[i].fadeToBlackBy(amount);
+  }
+}
+
+#define DISABLE_DITHER 0
+#define BINARY_DITHER 1
+
+// Nothing is sent, the simulator is called instead
+class CFastLED {
+public:
+  typedef void (*show_handler_t)();
+
+  void onShow(show_handler_t handler) { _showHandler = handler; }
+
+  void show() {
+    if (_showHandler) {
+      _showHandler();
+    }
+  }
+  void setBrightness(uint8_t) {}
+  void setDither(uint8_t) {}
+private:
+  show_handler_t _showHandler { nullptr };
+};
+
+extern CFastLED FastLED;
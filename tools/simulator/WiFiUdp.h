@@ -0,0 +1,140 @@
+#pragma once
+
+// UDP of the Arduino framework over the sockets of the host. The loopback
+// interface stands in for the network of the wheels: every instance of a test
+// binds the port passed to begin() plus its number on 127.0.0.1, and packets
+// to 255.255.255.255 are sent to basePort plus the number of every other
+// instance. Multicast groups are not joined, senders address the port of the
+// instance directly.
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+class IPAddress {
+public:
+  IPAddress() : IPAddress(0, 0, 0, 0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(a << 24 | b << 16 | c << 8 | d) {}
+  explicit IPAddress(uint32_t address) : _address(address) {}
+
+  uint32_t value() const { return _address; }
+  bool operator==(const IPAddress& other) const { return _address == other._address; }
+private:
+  // In host order
+  uint32_t _address;
+};
+
+class WiFiUDP {
+public:
+  // Set by the test before any instance begins
+  static uint16_t basePort;
+  static uint8_t instance;
+  static uint8_t instances;
+
+  ~WiFiUDP() { stop(); }
+
+  uint8_t begin(uint16_t port) {
+    stop();
+    _socket = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = addressOf(IPAddress(127, 0, 0, 1), port + instance);
+    if (_socket < 0 || bind(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      stop();
+      return 0;
+    }
+    fcntl(_socket, F_SETFL, O_NONBLOCK);
+    return 1;
+  }
+
+  uint8_t beginMulticast(IPAddress, uint16_t port) {
+    return begin(port);
+  }
+
+  void stop() {
+    if (_socket >= 0) {
+      close(_socket);
+      _socket = -1;
+    }
+  }
+
+  // Receives the next packet, returns its size or 0 when there is none
+  int parsePacket() {
+    sockaddr_in sender;
+    socklen_t senderSize = sizeof(sender);
+    const ssize_t size = recvfrom(_socket, _received, sizeof(_received), 0, reinterpret_cast<sockaddr*>(&sender), &senderSize);
+    if (size <= 0) {
+      _size = 0;
+      return 0;
+    }
+    _size = size;
+    _position = 0;
+    _remoteIP = IPAddress(ntohl(sender.sin_addr.s_addr));
+    _remotePort = ntohs(sender.sin_port);
+    return size;
+  }
+
+  int read(uint8_t* data, size_t size) {
+    if (size > _size - _position) {
+      size = _size - _position;
+    }
+    memcpy(data, &_received[_position], size);
+    _position += size;
+    return size;
+  }
+
+  IPAddress remoteIP() const { return _remoteIP; }
+  uint16_t remotePort() const { return _remotePort; }
+
+  int beginPacket(IPAddress ip, uint16_t port) {
+    _target = ip;
+    _targetPort = port;
+    _sending.clear();
+    return 1;
+  }
+
+  size_t write(const uint8_t* data, size_t size) {
+    _sending.insert(_sending.end(), data, data + size);
+    return size;
+  }
+
+  int endPacket() {
+    if (!(_target == IPAddress(255, 255, 255, 255))) {
+      return send(_target, _targetPort);
+    }
+    for (uint8_t other = 0; other < instances; other++) {
+      if (other != instance) {
+        send(IPAddress(127, 0, 0, 1), basePort + other);
+      }
+    }
+    return 1;
+  }
+private:
+  int _socket { -1 };
+  uint8_t _received[1500];
+  size_t _size { 0 };
+  size_t _position { 0 };
+  IPAddress _remoteIP;
+  uint16_t _remotePort { 0 };
+  IPAddress _target;
+  uint16_t _targetPort { 0 };
+  std::vector<uint8_t> _sending;
+
+  static sockaddr_in addressOf(IPAddress ip, uint16_t port) {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(ip.value());
+    address.sin_port = htons(port);
+    return address;
+  }
+
+  int send(IPAddress ip, uint16_t port) {
+    const sockaddr_in address = addressOf(ip, port);
+    return sendto(_socket, _sending.data(), _sending.size(), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) ==
+           (ssize_t)_sending.size();
+  }
+};
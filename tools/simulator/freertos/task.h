@@ -0,0 +1,9 @@
+#pragma once
+
+// The simulator runs everything on one thread, so the locks of the ESP32
+// code have nothing to do
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+
+inline void portENTER_CRITICAL(portMUX_TYPE*) {}
+inline void portEXIT_CRITICAL(portMUX_TYPE*) {}
@@ -0,0 +1,83 @@
+#pragma once
+
+// A DC motor on the LEDC for the host tools. The duty fades linearly like the
+// hardware fade, the wheel follows the speed of the duty with a delay and
+// stalls below a minimum duty. Times are in microseconds.
+#include <math.h>
+#include <stdint.h>
+
+#include "config.hpp"
+
+class SimulatedMotor {
+public:
+  struct Model {
+    // Speed relative to the one of Config::MOTOR_REVOLUTION_MS at MAX_SPEED
+    double gain;
+    // Time constant of the speed following the duty
+    double lagMs;
+    // Below this duty the wheel does not turn
+    uint8_t stallDuty;
+  };
+
+  explicit SimulatedMotor(const Model& model) : _model(model) {}
+
+  // Fades from the current duty to the new one, or sets it with 0. The motor
+  // must have been advanced to the time.
+  void fade(int64_t nowUs, uint8_t toDuty, uint32_t durationMs) {
+    _fromDuty = duty(nowUs);
+    _toDuty = toDuty;
+    _fadeStartUs = nowUs;
+    _fadeUs = (int64_t)durationMs * 1000;
+    _fades++;
+  }
+
+  double duty(int64_t timeUs) const {
+    const int64_t elapsedUs = timeUs - _fadeStartUs;
+    if (elapsedUs >= _fadeUs) {
+      return _toDuty;
+    }
+    if (elapsedUs <= 0) {
+      return _fromDuty;
+    }
+    return _fromDuty + (_toDuty - _fromDuty) * elapsedUs / _fadeUs;
+  }
+
+  // Advances to the time, returns whether the index mark passed and when
+  bool advance(int64_t nowUs, int64_t& pulseUs) {
+    bool pulsed = false;
+    while (_timeUs < nowUs) {
+      const int64_t stepUs = nowUs - _timeUs < STEP_US ? nowUs - _timeUs : STEP_US;
+      const double currentDuty = duty(_timeUs);
+      const double target = currentDuty < _model.stallDuty ? 0 : _model.gain * currentDuty / Config::MAX_SPEED;
+      _speed += (target - _speed) * (1 - exp(-stepUs / (_model.lagMs * 1000)));
+      const double previous = _revolutions;
+      _revolutions += _speed * stepUs / (Config::MOTOR_REVOLUTION_MS * 1000.0);
+      _timeUs += stepUs;
+      if (floor(_revolutions) > floor(previous)) {
+        // The mark passed within the step
+        const double fraction = (floor(_revolutions) - previous) / (_revolutions - previous);
+        pulseUs = _timeUs - stepUs + (int64_t)(fraction * stepUs);
+        pulsed = true;
+      }
+    }
+    return pulsed;
+  }
+
+  // Position of the wheel, the index mark is at 0
+  double revolutions() const { return _revolutions; }
+  // Relative to the speed at MAX_SPEED
+  double speed() const { return _speed; }
+  uint32_t fades() const { return _fades; }
+private:
+  static constexpr int64_t STEP_US = 100;
+
+  const Model _model;
+  double _fromDuty { 0 };
+  double _toDuty { 0 };
+  int64_t _fadeStartUs { 0 };
+  int64_t _fadeUs { 0 };
+  uint32_t _fades { 0 };
+  int64_t _timeUs { 0 };
+  double _speed { 0 };
+  double _revolutions { 0 };
+};
@@ -0,0 +1,663 @@
+// Runs the animations of the controller on the host against a virtual clock,
+// so minutes of animations take a fraction of a second:
+//
+//   SOURCES="animation interpolation island leds move output power random resume sequence snake sprinkle transition waves zone"
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -DTRANSITIONS_AVAILABLE -DINTERPOLATION_AVAILABLE -DZONES_AVAILABLE -DPREFETCH_AVAILABLE
+//     -DOUTPUT_STAGE_AVAILABLE -Itools/simulator -Iinclude tools/simulator/simulator.cpp $(printf "src/%s.cpp " $SOURCES)
+//     -o simulator
+//   ./simulator --catalog -o frames
+//   ./simulator --seconds 300 --seed 7 -c 20:next -c 45:disable:SnakeAnimation -o frames
+//
+// The controller is the one of the boards without the ESP32 specific
+// animations. Every animation is written as PNG with one row per 10 ms tick
+// (<number>-<name>.png), and all frames go into frames.bin:
+//
+//   "RWFS", version 1, number of LEDs, frame tick in ms
+//   'A', tick (uint32), length of the name, name      an animation started
+//   'F', tick (uint32), number of runs, runs           a frame was shown
+//
+// A run is the first LED, the number of LEDs and their RGB bytes, only the
+// LEDs which changed since the last frame are written. Numbers are little
+// endian. The same seed and commands always produce the same file, so two
+// versions of an animation can be compared with cmp.
+//
+// --golden <directory> runs the catalog and compares every frame of each
+// animation with <name>-<seed>.golden in the directory, any different pixel
+// makes the simulator exit with 1. Missing files are recorded, --update
+// records all of them again. A golden file holds the version header of
+// frames.bin ("RWGF") followed by the frames of one animation as tick since
+// its start (uint32), number of runs and runs. The number of seconds and the
+// commands have to be the same when recording and comparing.
+//
+// Commands simulate Home Assistant at a time in seconds: next, on, off,
+// enable:<animation>, disable:<animation>, weight:<animation>:<weight>,
+// brightness:<value> and zones:on/off. Animations are named like their class
+// or like the Home Assistant switch.
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "controller/controller.hpp"
+
+uint64_t simulatedMicros = 0;
+SimulatedSerial Serial;
+CFastLED FastLED;
+
+namespace {
+
+constexpr uint32_t FRAME_US = 10000;
+
+struct Command {
+  uint32_t ms;
+  std::string action;
+  std::string animation;
+  uint8_t value;
+};
+
+struct Finished {};
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+  static uint32_t table[256];
+  if (table[1] == 0) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t value = i;
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        value = value & 1 ? 0xedb88320 ^ (value >> 1) : value >> 1;
+      }
+      table[i] = value;
+    }
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void appendLittleEndian(std::vector<uint8_t>& data, uint32_t value) {
+  for (uint8_t shift = 0; shift < 32; shift += 8) {
+    data.push_back(value >> shift);
+  }
+}
+
+void appendBigEndian(std::vector<uint8_t>& data, uint32_t value) {
+  for (int8_t shift = 24; shift >= 0; shift -= 8) {
+    data.push_back(value >> shift);
+  }
+}
+
+void writeChunk(FILE* file, const char* type, const std::vector<uint8_t>& body) {
+  std::vector<uint8_t> chunk(type, type + 4);
+  chunk.insert(chunk.end(), body.begin(), body.end());
+  std::vector<uint8_t> length;
+  appendBigEndian(length, body.size());
+  std::vector<uint8_t> crc;
+  appendBigEndian(crc, crc32(chunk.data(), chunk.size()));
+  fwrite(length.data(), 1, length.size(), file);
+  fwrite(chunk.data(), 1, chunk.size(), file);
+  fwrite(crc.data(), 1, crc.size(), file);
+}
+
+// Writes the bits of a deflate stream, least significant bit first
+class BitWriter {
+public:
+  std::vector<uint8_t> bytes;
+
+  void write(uint32_t value, uint8_t count) {
+    for (uint8_t bit = 0; bit < count; bit++) {
+      writeBit(value >> bit & 1);
+    }
+  }
+
+  // Huffman codes start with their most significant bit
+  void writeCode(uint32_t code, uint8_t count) {
+    while (count-- > 0) {
+      writeBit(code >> count & 1);
+    }
+  }
+private:
+  uint8_t _used { 8 };
+
+  void writeBit(uint8_t bit) {
+    if (_used == 8) {
+      bytes.push_back(0);
+      _used = 0;
+    }
+    bytes.back() |= bit << _used++;
+  }
+};
+
+void writeLiteral(BitWriter& writer, uint16_t symbol) {
+  if (symbol < 144) {
+    writer.writeCode(0x30 + symbol, 8);
+  } else if (symbol < 256) {
+    writer.writeCode(0x190 + symbol - 144, 9);
+  } else if (symbol < 280) {
+    writer.writeCode(symbol - 256, 7);
+  } else {
+    writer.writeCode(0xc0 + symbol - 280, 8);
+  }
+}
+
+// Repeats the previous byte, length 3 to 258
+void writeRepeat(BitWriter& writer, uint16_t length) {
+  static const uint16_t bases[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+  static const uint8_t extraBits[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                       3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+  uint8_t code = sizeof(bases) / sizeof(bases[0]) - 1;
+  while (bases[code] > length) {
+    code--;
+  }
+  writeLiteral(writer, 257 + code);
+  writer.write(length - bases[code], extraBits[code]);
+  // Distance 1
+  writer.writeCode(0, 5);
+}
+
+// Every row is stored as difference to the one above (PNG filter "Up"), so
+// the unchanged LEDs become runs of zeros, which are compressed as repeats
+// of the previous byte with the fixed Huffman codes of deflate.
+bool writePng(const std::string& path, const std::vector<uint8_t>& rgb, uint16_t width, uint32_t height) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    fprintf(stderr, "%s: cannot be written\n", path.c_str());
+    return false;
+  }
+  static const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+  fwrite(signature, 1, sizeof(signature), file);
+
+  std::vector<uint8_t> header;
+  appendBigEndian(header, width);
+  appendBigEndian(header, height);
+  // 8 bit RGB, no interlacing
+  header.insert(header.end(), { 8, 2, 0, 0, 0 });
+  writeChunk(file, "IHDR", header);
+
+  const uint32_t rowSize = width * 3;
+  std::vector<uint8_t> raw;
+  for (uint32_t row = 0; row < height; row++) {
+    raw.push_back(2);
+    for (uint32_t i = row * rowSize; i < (row + 1) * rowSize; i++) {
+      raw.push_back(rgb[i] - (row > 0 ? rgb[i - rowSize] : 0));
+    }
+  }
+
+  BitWriter writer;
+  // A single final block with fixed codes
+  writer.write(1, 1);
+  writer.write(1, 2);
+  for (size_t i = 0; i < raw.size();) {
+    writeLiteral(writer, raw[i]);
+    size_t end = i + 1;
+    while (end < raw.size() && raw[end] == raw[i] && end - i <= 258) {
+      end++;
+    }
+    const uint16_t repeated = end - i - 1;
+    if (repeated >= 3) {
+      writeRepeat(writer, repeated);
+      i = end;
+    } else {
+      i++;
+    }
+  }
+  writeLiteral(writer, 256);
+
+  std::vector<uint8_t> compressed = { 0x78, 0x01 };
+  compressed.insert(compressed.end(), writer.bytes.begin(), writer.bytes.end());
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (uint8_t value : raw) {
+    a = (a + value) % 65521;
+    b = (b + a) % 65521;
+  }
+  appendBigEndian(compressed, b << 16 | a);
+  writeChunk(file, "IDAT", compressed);
+  writeChunk(file, "IEND", {});
+  fclose(file);
+  return true;
+}
+
+struct GoldenFrame {
+  uint32_t tick;
+  uint8_t rgb[NUM_LEDS * 3];
+};
+
+// Replays the runs of a golden file into whole frames
+bool decodeGolden(const std::vector<uint8_t>& data, std::vector<GoldenFrame>& frames) {
+  size_t position = 7;
+  GoldenFrame frame;
+  memset(frame.rgb, 0, sizeof(frame.rgb));
+  while (position < data.size()) {
+    if (position + 5 > data.size()) {
+      return false;
+    }
+    frame.tick = data[position] | data[position + 1] << 8 | data[position + 2] << 16 | (uint32_t)data[position + 3] << 24;
+    uint8_t runs = data[position + 4];
+    position += 5;
+    while (runs-- > 0) {
+      if (position + 2 > data.size()) {
+        return false;
+      }
+      const uint8_t first = data[position];
+      const uint8_t count = data[position + 1];
+      position += 2;
+      if (first + count > NUM_LEDS || position + count * 3 > data.size()) {
+        return false;
+      }
+      memcpy(&frame.rgb[first * 3], &data[position], count * 3);
+      position += count * 3;
+    }
+    frames.push_back(frame);
+  }
+  return true;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  uint8_t buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    data.insert(data.end(), buffer, buffer + read);
+  }
+  fclose(file);
+  return true;
+}
+
+class Simulation;
+Simulation* simulation = nullptr;
+
+class SimulatedController final : public Ferriswheel::Controller<0> {
+public:
+  virtual void run() override {
+    this->outsideLoop();
+  }
+
+  bool setEnabled(const std::string& animation, bool enabled) {
+#define X(field)                                                  \
+    if (animation == #field || animation == field::NAME) {        \
+      set##field##Enabled(enabled);                               \
+      return true;                                                \
+    }
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+    return false;
+  }
+
+  bool setWeight(const std::string& animation, uint8_t weight) {
+#define X(field)                                                  \
+    if (animation == #field || animation == field::NAME) {        \
+      setAnimationWeight(Ferriswheel::field##Id, weight);         \
+      return true;                                                \
+    }
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+    return false;
+  }
+protected:
+  virtual void setupTimer() override {}
+  virtual void delayFrame() override;
+};
+
+class Simulation {
+public:
+  std::string directory { "." };
+  uint32_t seed { 1 };
+  uint32_t limitMs { 600000 };
+  bool output { false };
+  std::vector<Command> commands;
+  // Golden files are compared with the frames, or recorded when missing
+  std::string goldenDirectory;
+  bool updateGolden { false };
+  uint32_t goldenFailures { 0 };
+
+  bool begin() {
+    mkdir(directory.c_str(), 0755);
+    const std::string path = directory + "/frames.bin";
+    _stream = fopen(path.c_str(), "wb");
+    if (!_stream) {
+      fprintf(stderr, "%s: cannot be written\n", path.c_str());
+      return false;
+    }
+    const uint8_t header[] = { 'R', 'W', 'F', 'S', 1, NUM_LEDS, FRAME_US / 1000 };
+    fwrite(header, 1, sizeof(header), _stream);
+    simulation = this;
+    FastLED.onShow(&Simulation::shown);
+    return true;
+  }
+
+  void end() {
+    finishAnimation();
+    fclose(_stream);
+  }
+
+  // Runs the controller until the limit or, with only one animation, until it ended
+  void run(SimulatedController& controller, bool singleAnimation) {
+    _controller = &controller;
+    _singleAnimation = singleAnimation;
+    _animationsStarted = 0;
+    _startUs = simulatedMicros;
+    _nextCommand = 0;
+    seedRandom(seed);
+    allBlack();
+    memset(_shown, 0, sizeof(_shown));
+    controller.onPublishAnimation(&Simulation::animationStarted);
+    controller.setAnimationsEnabled(true);
+    try {
+      controller.run();
+    } catch (const Finished&) {
+    }
+    finishAnimation();
+  }
+
+  void tick() {
+    simulatedMicros += FRAME_US;
+    const uint32_t elapsedMs = (simulatedMicros - _startUs) / 1000;
+    while (_nextCommand < commands.size() && commands[_nextCommand].ms <= elapsedMs) {
+      apply(commands[_nextCommand++]);
+    }
+    if (_recording) {
+      _rows.insert(_rows.end(), _shown, _shown + sizeof(_shown));
+    }
+    if (elapsedMs >= limitMs) {
+      throw Finished();
+    }
+  }
+
+  uint32_t animationCount() const { return _fileNumber; }
+  uint32_t goldenCount() const { return _goldenCount; }
+private:
+  FILE* _stream { nullptr };
+  SimulatedController* _controller { nullptr };
+  bool _singleAnimation { false };
+  uint8_t _animationsStarted { 0 };
+  uint64_t _startUs { 0 };
+  size_t _nextCommand { 0 };
+
+  uint8_t _shown[NUM_LEDS * 3];
+  bool _recording { false };
+  std::string _name;
+  std::vector<uint8_t> _rows;
+  uint32_t _fileNumber { 0 };
+
+  uint32_t _startTick { 0 };
+  std::vector<uint8_t> _golden;
+  uint32_t _goldenCount { 0 };
+
+  uint32_t currentTick() const { return simulatedMicros / FRAME_US; }
+
+  void writeTick() {
+    const uint32_t tick = currentTick();
+    const uint8_t bytes[] = { (uint8_t)tick, (uint8_t)(tick >> 8), (uint8_t)(tick >> 16), (uint8_t)(tick >> 24) };
+    fwrite(bytes, 1, sizeof(bytes), _stream);
+  }
+
+  static void animationStarted(const Animation* animation) {
+    simulation->startAnimation(animation);
+  }
+
+  void startAnimation(const Animation* animation) {
+    if (_singleAnimation && animation != nullptr && _animationsStarted++ > 0) {
+      throw Finished();
+    }
+    finishAnimation();
+    _name = animation != nullptr ? animation->name() : "";
+    fputc('A', _stream);
+    writeTick();
+    fputc(_name.size(), _stream);
+    fwrite(_name.data(), 1, _name.size(), _stream);
+    _recording = animation != nullptr;
+    _startTick = currentTick();
+    _golden.assign({ 'R', 'W', 'G', 'F', 1, NUM_LEDS, FRAME_US / 1000 });
+  }
+
+  void finishAnimation() {
+    if (!_recording) {
+      return;
+    }
+    _recording = false;
+    std::string name = _name;
+    for (char& character : name) {
+      if (character == ' ' || character == '/') {
+        character = '-';
+      }
+    }
+    checkGolden(name);
+    char number[8];
+    snprintf(number, sizeof(number), "%03u-", ++_fileNumber);
+    const uint32_t rows = _rows.size() / sizeof(_shown);
+    if (rows > 0) {
+      writePng(directory + "/" + number + name + ".png", _rows, NUM_LEDS, rows);
+    }
+    _rows.clear();
+  }
+
+  void checkGolden(const std::string& name) {
+    if (goldenDirectory.empty()) {
+      return;
+    }
+    char suffix[24];
+    snprintf(suffix, sizeof(suffix), "-%u.golden", seed);
+    const std::string path = goldenDirectory + "/" + name + suffix;
+    _goldenCount++;
+    std::vector<uint8_t> golden;
+    if (!updateGolden && readFile(path, golden)) {
+      if (golden != _golden) {
+        reportDifference(path, golden);
+        goldenFailures++;
+      }
+      return;
+    }
+    mkdir(goldenDirectory.c_str(), 0755);
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+      fprintf(stderr, "%s: cannot be written\n", path.c_str());
+      goldenFailures++;
+      return;
+    }
+    fwrite(_golden.data(), 1, _golden.size(), file);
+    fclose(file);
+  }
+
+  // Prints the first pixel which differs from the golden file
+  void reportDifference(const std::string& path, const std::vector<uint8_t>& golden) const {
+    std::vector<GoldenFrame> expected;
+    std::vector<GoldenFrame> actual;
+    if (golden.size() < 7 || memcmp(golden.data(), _golden.data(), 7) != 0 || !decodeGolden(golden, expected)) {
+      fprintf(stderr, "%s: not a golden file of this version\n", path.c_str());
+      return;
+    }
+    decodeGolden(_golden, actual);
+    for (size_t index = 0; index < expected.size() && index < actual.size(); index++) {
+      const GoldenFrame& want = expected[index];
+      const GoldenFrame& got = actual[index];
+      if (want.tick != got.tick) {
+        fprintf(stderr, "%s: frame %zu shown at tick %u instead of %u\n", path.c_str(), index, got.tick, want.tick);
+        return;
+      }
+      for (uint8_t led = 0; led < NUM_LEDS; led++) {
+        const uint8_t* a = &want.rgb[led * 3];
+        const uint8_t* b = &got.rgb[led * 3];
+        if (memcmp(a, b, 3) != 0) {
+          fprintf(stderr, "%s: tick %u, LED %u is %02x%02x%02x instead of %02x%02x%02x\n",
+                  path.c_str(), got.tick, led, b[0], b[1], b[2], a[0], a[1], a[2]);
+          return;
+        }
+      }
+    }
+    fprintf(stderr, "%s: %zu frames instead of %zu\n", path.c_str(), actual.size(), expected.size());
+  }
+
+  static void shown() {
+    simulation->recordFrame();
+  }
+
+  // Writes the runs of LEDs which changed since the last shown frame
+  void recordFrame() {
+    const uint8_t* const frame = reinterpret_cast<const uint8_t*>(output ? outputLeds : leds);
+    std::vector<uint8_t> runs;
+    uint8_t runCount = 0;
+    for (uint8_t led = 0; led < NUM_LEDS;) {
+      if (memcmp(&frame[led * 3], &_shown[led * 3], 3) == 0) {
+        led++;
+        continue;
+      }
+      uint8_t end = led + 1;
+      while (end < NUM_LEDS && memcmp(&frame[end * 3], &_shown[end * 3], 3) != 0) {
+        end++;
+      }
+      runs.push_back(led);
+      runs.push_back(end - led);
+      runs.insert(runs.end(), &frame[led * 3], &frame[end * 3]);
+      runCount++;
+      led = end;
+    }
+    if (runCount == 0) {
+      return;
+    }
+    memcpy(_shown, frame, sizeof(_shown));
+    fputc('F', _stream);
+    writeTick();
+    fputc(runCount, _stream);
+    fwrite(runs.data(), 1, runs.size(), _stream);
+    if (_recording) {
+      appendLittleEndian(_golden, currentTick() - _startTick);
+      _golden.push_back(runCount);
+      _golden.insert(_golden.end(), runs.begin(), runs.end());
+    }
+  }
+
+  void apply(const Command& command) {
+    bool known = true;
+    if (command.action == "next") {
+      _controller->requestNextAnimation();
+    } else if (command.action == "on" || command.action == "off") {
+      _controller->setAnimationsEnabled(command.action == "on");
+    } else if (command.action == "enable" || command.action == "disable") {
+      known = _controller->setEnabled(command.animation, command.action == "enable");
+    } else if (command.action == "weight") {
+      known = _controller->setWeight(command.animation, command.value);
+    } else if (command.action == "brightness") {
+      _controller->setBrightness(command.value);
+#ifdef ZONES_AVAILABLE
+    } else if (command.action == "zones") {
+      _controller->setZonesEnabled(command.animation == "on");
+#endif // ZONES_AVAILABLE
+    } else {
+      known = false;
+    }
+    if (!known) {
+      fprintf(stderr, "Unknown command %s %s\n", command.action.c_str(), command.animation.c_str());
+    }
+  }
+};
+
+void SimulatedController::delayFrame() {
+  simulation->tick();
+}
+
+// <seconds>:<action>[:<animation or value>[:<value>]]
+bool parseCommand(const std::string& text, Command& command) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  while (true) {
+    const size_t separator = text.find(':', start);
+    parts.push_back(text.substr(start, separator - start));
+    if (separator == std::string::npos) {
+      break;
+    }
+    start = separator + 1;
+  }
+  if (parts.size() < 2) {
+    return false;
+  }
+  command.ms = atof(parts[0].c_str()) * 1000;
+  command.action = parts[1];
+  command.animation = parts.size() > 2 ? parts[2] : "";
+  command.value = atoi(parts.size() > 3 ? parts[3].c_str() : command.animation.c_str());
+  return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+  Simulation simulation;
+  bool catalog = false;
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (argument == "--catalog") {
+      catalog = true;
+    } else if (argument == "--output") {
+      simulation.output = true;
+    } else if (argument == "--verbose") {
+      Serial.verbose = true;
+    } else if (argument == "--golden" && hasValue) {
+      simulation.goldenDirectory = argv[++i];
+      catalog = true;
+    } else if (argument == "--update") {
+      simulation.updateGolden = true;
+    } else if (argument == "-o" && hasValue) {
+      simulation.directory = argv[++i];
+    } else if (argument == "--seed" && hasValue) {
+      simulation.seed = strtoul(argv[++i], nullptr, 0);
+    } else if (argument == "--seconds" && hasValue) {
+      simulation.limitMs = atof(argv[++i]) * 1000;
+    } else if (argument == "-c" && hasValue) {
+      Command command;
+      if (!parseCommand(argv[++i], command)) {
+        fprintf(stderr, "Invalid command %s\n", argv[i]);
+        return 1;
+      }
+      simulation.commands.push_back(command);
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--catalog] [--seconds <limit>] [--seed <seed>] [-c <seconds>:<command>]...\n"
+              "       [--golden <directory> [--update]] [--output] [--verbose] [-o <directory>]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  std::stable_sort(simulation.commands.begin(), simulation.commands.end(),
+                   [](const Command& a, const Command& b) { return a.ms < b.ms; });
+  if (!simulation.begin()) {
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  if (catalog) {
+    // Every animation once on its own
+    for (uint8_t id = 0; id < Ferriswheel::ANIMATION_COUNT; id++) {
+      SimulatedController* const controller = new SimulatedController();
+#define X(field) \
+      controller->set##field##Enabled(Ferriswheel::field##Id == id);
+
+ENABLED_ANIMATIONS_LIST
+#undef X
+      simulation.run(*controller, true);
+      delete controller;
+    }
+  } else {
+    SimulatedController* const controller = new SimulatedController();
+    simulation.run(*controller, false);
+    delete controller;
+  }
+  simulation.end();
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double simulatedSeconds = simulatedMicros / 1e6;
+  printf("%u animations, %.1f s simulated in %.2f s (%.0fx real time)\n",
+         simulation.animationCount(), simulatedSeconds, seconds, simulatedSeconds / seconds);
+  if (!simulation.goldenDirectory.empty()) {
+    printf("%u of %u animations differ from the golden files\n", simulation.goldenFailures, simulation.goldenCount());
+  }
+  return simulation.goldenFailures > 0 ? 1 : 0;
+}
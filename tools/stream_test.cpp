@@ -0,0 +1,253 @@
+// Sends DDP and E1.31 frames from a separate process over localhost to a
+// PixelStream and checks the received frames and the dropped packets:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -Itools/simulator -Iinclude tools/stream_test.cpp
+//     src/leds.cpp src/random.cpp src/animation.cpp -o stream_test
+//   ./stream_test
+//
+// The sender leaves gaps in the sequence numbers of both protocols, and for
+// E1.31 also repeats a packet, sends an old one and restarts its sequence
+// like a restarted sequencer. Only the gaps count as dropped packets, the
+// repeated and old packets are discarded. Returns 1 when a frame differs, is
+// missing or the dropped packets were counted wrong.
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stream.hpp"
+
+using Ferriswheel::PixelStream;
+
+uint64_t simulatedMicros = 0;
+SimulatedSerial Serial;
+uint16_t WiFiUDP::basePort = Config::STREAM_DDP_PORT;
+uint8_t WiFiUDP::instance = 0;
+uint8_t WiFiUDP::instances = 2;
+
+namespace {
+
+// Bound by PixelStream, only the port of the DDP is configurable
+constexpr uint16_t E131_PORT = 5568;
+constexpr uint16_t E131_HEADER_SIZE = 126;
+constexpr uint8_t DDP_HEADER_SIZE = 10;
+constexpr uint8_t DDP_FLAG_PUSH = 0x01;
+constexpr uint8_t DDP_VERSION = 0x40;
+// Every DDP frame is sent in two packets
+constexpr uint16_t DDP_SPLIT = 150;
+
+constexpr uint8_t DDP_FRAMES = 40;
+constexpr uint16_t E131_FRAMES = 400;
+constexpr int64_t TIMEOUT_US = 10000000;
+
+enum class Protocol : uint8_t { Ddp, E131 };
+
+struct Packet {
+  Protocol protocol;
+  uint16_t frame;
+  uint8_t sequence;
+  // Whether the receiver shows the frame of this packet
+  bool expected;
+};
+
+struct Schedule {
+  std::vector<Packet> packets;
+  uint32_t droppedPackets;
+};
+
+// The packets in the order they are sent, a DDP packet stands for both parts
+Schedule schedule() {
+  Schedule result { {}, 0 };
+  // DDP counts from 1 to 15, two packets per frame. Frames 10 and 25 are lost.
+  uint8_t ddpSequence = 0;
+  for (uint16_t frame = 0; frame < DDP_FRAMES; frame++) {
+    const uint8_t sequence = ddpSequence % 15 + 1;
+    ddpSequence = (ddpSequence + 2) % 15;
+    if (frame == 10 || frame == 25) {
+      result.droppedPackets += 2;
+      continue;
+    }
+    result.packets.push_back({ Protocol::Ddp, frame, sequence, true });
+  }
+
+  // E1.31 counts from 0 to 255 in one universe
+  uint8_t e131Offset = 0;
+  for (uint16_t frame = 0; frame < E131_FRAMES; frame++) {
+    if (frame == 100) {
+      // The sequencer restarts
+      e131Offset = -100;
+    }
+    const uint8_t sequence = frame + e131Offset;
+    if (frame >= 20 && frame <= 22) {
+      result.droppedPackets++;
+      continue;
+    }
+    result.packets.push_back({ Protocol::E131, frame, sequence, true });
+    if (frame == 40) {
+      result.packets.push_back({ Protocol::E131, frame, sequence, false });
+    } else if (frame == 60) {
+      result.packets.push_back({ Protocol::E131, 55, (uint8_t)(55 + e131Offset), false });
+    }
+  }
+  return result;
+}
+
+uint8_t pixel(uint16_t frame, uint16_t byte) {
+  return frame * 37 + byte * 11;
+}
+
+int64_t realEpochUs;
+
+int64_t realUs() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000000LL + time.tv_nsec / 1000 - realEpochUs;
+}
+
+void updateClock() {
+  simulatedMicros = realUs();
+}
+
+void sendDdp(WiFiUDP& udp, const Packet& packet) {
+  for (uint16_t offset = 0; offset < sizeof(leds); offset += DDP_SPLIT) {
+    const uint16_t length = min((uint16_t)(sizeof(leds) - offset), DDP_SPLIT);
+    const bool last = offset + length == sizeof(leds);
+    // Each part has its own sequence number
+    const uint8_t sequence = last ? packet.sequence % 15 + 1 : packet.sequence;
+    const uint8_t header[DDP_HEADER_SIZE] = {
+      (uint8_t)(DDP_VERSION | (last ? DDP_FLAG_PUSH : 0)), sequence, 0, 1,
+      0, 0, (uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(length >> 8), (uint8_t)length,
+    };
+    uint8_t data[DDP_SPLIT];
+    for (uint16_t i = 0; i < length; i++) {
+      data[i] = pixel(packet.frame, offset + i);
+    }
+    udp.beginPacket(IPAddress(127, 0, 0, 1), Config::STREAM_DDP_PORT);
+    udp.write(header, sizeof(header));
+    udp.write(data, length);
+    udp.endPacket();
+  }
+}
+
+void sendE131(WiFiUDP& udp, const Packet& packet) {
+  static constexpr uint8_t identifier[] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+  uint8_t header[E131_HEADER_SIZE] = {};
+  memcpy(&header[4], identifier, sizeof(identifier));
+  header[21] = 0x04;
+  header[43] = 0x02;
+  header[111] = packet.sequence;
+  header[113] = Config::STREAM_E131_UNIVERSE >> 8;
+  header[114] = Config::STREAM_E131_UNIVERSE & 0xff;
+  header[117] = 0x02;
+  // Property values, the start code and the channels
+  const uint16_t count = sizeof(leds) + 1;
+  header[123] = count >> 8;
+  header[124] = count & 0xff;
+  uint8_t data[sizeof(leds)];
+  for (uint16_t i = 0; i < sizeof(data); i++) {
+    data[i] = pixel(packet.frame, i);
+  }
+  udp.beginPacket(IPAddress(127, 0, 0, 1), E131_PORT);
+  udp.write(header, sizeof(header));
+  udp.write(data, sizeof(data));
+  udp.endPacket();
+}
+
+int runSender() {
+  WiFiUDP::instance = 1;
+  WiFiUDP udp;
+  if (!udp.begin(Config::STREAM_DDP_PORT)) {
+    return 1;
+  }
+  for (const Packet& packet : schedule().packets) {
+    if (packet.protocol == Protocol::Ddp) {
+      sendDdp(udp, packet);
+    } else {
+      sendE131(udp, packet);
+    }
+    // The receive buffer of the loopback only holds a few hundred packets
+    usleep(500);
+  }
+  return 0;
+}
+
+bool frameMatches(uint16_t frame) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(leds);
+  for (uint16_t i = 0; i < sizeof(leds); i++) {
+    if (bytes[i] != pixel(frame, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int main() {
+  realEpochUs = 0;
+  realEpochUs = realUs();
+  updateClock();
+
+  PixelStream stream;
+  stream.begin();
+  stream.start();
+  const pid_t sender = fork();
+  if (sender == 0) {
+    _exit(runSender());
+  }
+
+  const Schedule expected = schedule();
+  std::vector<const Packet*> frames;
+  for (const Packet& packet : expected.packets) {
+    if (packet.expected) {
+      frames.push_back(&packet);
+    }
+  }
+  uint16_t received[2] = { 0, 0 };
+  uint16_t sent[2] = { 0, 0 };
+  uint16_t wrong = 0;
+  size_t next = 0;
+  for (const Packet* frame : frames) {
+    sent[static_cast<uint8_t>(frame->protocol)]++;
+  }
+  while (next < frames.size() && realUs() < TIMEOUT_US) {
+    updateClock();
+    if (!stream.receiveFrame()) {
+      usleep(50);
+      continue;
+    }
+    const Packet& frame = *frames[next++];
+    if (frameMatches(frame.frame)) {
+      received[static_cast<uint8_t>(frame.protocol)]++;
+    } else {
+      printf("Frame %u of %s differs\n", frame.frame, frame.protocol == Protocol::Ddp ? "DDP" : "E1.31");
+      wrong++;
+    }
+    stream.shown();
+  }
+
+  int status;
+  waitpid(sender, &status, 0);
+  bool passed = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  if (!passed) {
+    printf("The sender failed\n");
+  }
+  // An unexpected frame would be one more
+  updateClock();
+  passed &= !stream.receiveFrame();
+
+  simulatedMicros += 1100000;
+  PixelStream::Statistics statistics;
+  const bool reported = stream.takeStatistics(statistics);
+  const uint32_t dropped = reported ? statistics.droppedPackets : 0;
+  printf("%-8s %8s %8s\n", "Protocol", "Sent", "Received");
+  printf("%-8s %8u %8u\n", "DDP", sent[0], received[0]);
+  printf("%-8s %8u %8u\n", "E1.31", sent[1], received[1]);
+  printf("Dropped packets: %u expected, %u counted\n", expected.droppedPackets, dropped);
+  passed &= reported && wrong == 0 && received[0] == sent[0] && received[1] == sent[1] && dropped == expected.droppedPackets;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+  return passed ? 0 : 1;
+}
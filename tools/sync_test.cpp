@@ -0,0 +1,262 @@
+// Runs one leader and several followers of WheelSync as separate processes on
+// localhost and checks that they start the announced animations together:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -Itools/simulator -Iinclude tools/sync_test.cpp src/sync.cpp
+//     src/snake.cpp src/sprinkle.cpp src/waves.cpp src/leds.cpp src/random.cpp src/animation.cpp -o sync_test
+//   ./sync_test [followers]
+//
+// Every instance has a clock with its own offset and drift and only sees the
+// leader through UDP, see tools/simulator/WiFiUdp.h. The leader announces a
+// few animations, every instance notes the real time when the start is due
+// and again two seconds of the leader later, and calculates the frames of the
+// animation with the announced seed. Returns 1 when a follower is more than a
+// frame away from the leader or calculated other frames.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "animationbuffer.hpp"
+#include "snake.hpp"
+#include "sprinkle.hpp"
+#include "sync.hpp"
+#include "waves.hpp"
+
+using Ferriswheel::WheelSync;
+
+uint64_t simulatedMicros = 0;
+SimulatedSerial Serial;
+uint16_t WiFiUDP::basePort = Config::SYNC_PORT;
+uint8_t WiFiUDP::instance = 0;
+uint8_t WiFiUDP::instances = 1;
+
+namespace {
+
+constexpr int64_t FRAME_US = 10000;
+constexpr uint8_t ROUNDS = 4;
+constexpr uint8_t ANIMATIONS = 4;
+// The followers need a few requests before the first start
+constexpr int64_t WARMUP_US = 3000000;
+// The second measurement after the start, in time of the leader
+constexpr int64_t LATER_US = 2000000;
+constexpr int64_t TIMEOUT_US = WARMUP_US + ROUNDS * (LATER_US + 1000000) + 5000000;
+constexpr uint16_t MAXIMUM_FRAMES = 1000;
+
+// Drift of the clocks in parts per million, the first one is the leader's
+const int16_t driftPpm[] = { 0, 80, -60, 40, -100, 20, -30, 100 };
+constexpr uint8_t MAXIMUM_INSTANCES = sizeof(driftPpm) / sizeof(driftPpm[0]);
+
+struct Result {
+  uint8_t instance;
+  int64_t startUs;
+  // Real time since the start of the test
+  int64_t startedUs;
+  int64_t laterUs;
+  uint32_t checksum;
+};
+
+int64_t realEpochUs;
+
+int64_t realUs() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000000LL + time.tv_nsec / 1000 - realEpochUs;
+}
+
+// The clock of an instance, set before every call of WheelSync
+struct Clock {
+  int64_t offsetUs;
+  int16_t ppm;
+
+  void update() const {
+    const int64_t real = realUs();
+    simulatedMicros = offsetUs + real + real * ppm / 1000000;
+  }
+};
+
+// Calls the loop of WheelSync until the time of the leader is reached
+bool waitUntil(WheelSync& sync, const Clock& clock, int64_t leaderUs) {
+  const int64_t timeoutUs = realUs() + LATER_US * 2;
+  while (true) {
+    clock.update();
+    sync.loop();
+    if (sync.now() >= leaderUs) {
+      return true;
+    }
+    if (realUs() > timeoutUs) {
+      return false;
+    }
+    usleep(50);
+  }
+}
+
+// FNV-1a over all frames of the animation
+uint32_t render(uint8_t animation, uint32_t seed) {
+  seedRandom(seed);
+  AnimationBuffer buffer;
+  switch (animation) {
+  case 0:
+    buffer.create<SnakeAnimation>();
+    break;
+  case 1:
+    buffer.create<SprinkleAnimation>();
+    break;
+  case 2:
+    buffer.create<WavingColors>();
+    break;
+  default:
+    buffer.create<ShootingStars>();
+    break;
+  }
+  Animation* current = buffer.get();
+  fill_solid(leds, NUM_LEDS, CRGB::Black);
+  current->start();
+  uint32_t checksum = 2166136261u;
+  for (uint16_t frame = 0; frame < MAXIMUM_FRAMES && !current->finished(); frame++) {
+    current->frame();
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(leds);
+    for (uint16_t i = 0; i < sizeof(leds); i++) {
+      checksum = (checksum ^ bytes[i]) * 16777619u;
+    }
+  }
+  return checksum;
+}
+
+bool runStart(WheelSync& sync, const Clock& clock, const WheelSync::Start& start, int output) {
+  Result result { WiFiUDP::instance, start.startUs, 0, 0, 0 };
+  if (!waitUntil(sync, clock, start.startUs)) {
+    return false;
+  }
+  result.startedUs = realUs();
+  result.checksum = render(start.animation, start.seed);
+  if (!waitUntil(sync, clock, start.startUs + LATER_US)) {
+    return false;
+  }
+  result.laterUs = realUs();
+  return write(output, &result, sizeof(result)) == sizeof(result);
+}
+
+int runLeader(const Clock& clock, int output) {
+  WheelSync sync;
+  sync.begin();
+  sync.setRole(WheelSync::Role::Leader);
+  clock.update();
+  if (!waitUntil(sync, clock, sync.now() + WARMUP_US)) {
+    return 1;
+  }
+  for (uint8_t round = 0; round < ROUNDS; round++) {
+    clock.update();
+    // Like createLeaderAnimation(), on a frame tick
+    const int64_t startUs = (sync.now() + Config::SYNC_START_DELAY_MS * 1000LL + FRAME_US - 1) / FRAME_US * FRAME_US;
+    const WheelSync::Start start { (uint8_t)(round % ANIMATIONS), ANIMATIONS, (uint32_t)realUs() ^ round, startUs };
+    sync.announce(start);
+    if (!runStart(sync, clock, start, output)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int runFollower(const Clock& clock, int output) {
+  WheelSync sync;
+  sync.begin();
+  sync.setRole(WheelSync::Role::Follower);
+  uint8_t rounds = 0;
+  while (rounds < ROUNDS && realUs() < TIMEOUT_US) {
+    clock.update();
+    sync.loop();
+    WheelSync::Start start;
+    if (sync.takeStart(start)) {
+      if (start.animationCount != ANIMATIONS || !sync.synchronized() || !runStart(sync, clock, start, output)) {
+        return 1;
+      }
+      rounds++;
+    }
+    usleep(50);
+  }
+  return rounds == ROUNDS ? 0 : 1;
+}
+
+}
+
+int main(int argc, char** argv) {
+  const int followers = argc > 1 ? atoi(argv[1]) : 4;
+  if (followers < 1 || followers >= MAXIMUM_INSTANCES) {
+    fprintf(stderr, "Between 1 and %u followers\n", MAXIMUM_INSTANCES - 1);
+    return 2;
+  }
+  WiFiUDP::instances = followers + 1;
+  int pipeEnds[2];
+  if (pipe(pipeEnds) != 0) {
+    perror("pipe");
+    return 2;
+  }
+  realEpochUs = 0;
+  realEpochUs = realUs();
+
+  std::vector<pid_t> children;
+  for (uint8_t instance = 0; instance < WiFiUDP::instances; instance++) {
+    // The clocks of the wheels started at different times
+    const Clock clock { 1000000000LL + instance * 7345678LL, driftPpm[instance] };
+    const pid_t child = fork();
+    if (child == 0) {
+      close(pipeEnds[0]);
+      WiFiUDP::instance = instance;
+      _exit(instance == 0 ? runLeader(clock, pipeEnds[1]) : runFollower(clock, pipeEnds[1]));
+    }
+    children.push_back(child);
+  }
+  close(pipeEnds[1]);
+
+  // Results of all instances by the time of the start
+  std::map<int64_t, std::vector<Result>> starts;
+  Result result;
+  while (read(pipeEnds[0], &result, sizeof(result)) == sizeof(result)) {
+    starts[result.startUs].push_back(result);
+  }
+  bool passed = true;
+  for (size_t i = 0; i < children.size(); i++) {
+    int status;
+    waitpid(children[i], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      printf("Instance %zu failed\n", i);
+      passed = false;
+    }
+  }
+
+  printf("%-6s %9s %18s %18s %9s\n", "Start", "Instances", "Start error (ms)", "After 2 s (ms)", "Frames");
+  uint8_t round = 0;
+  for (const auto& start : starts) {
+    const std::vector<Result>& results = start.second;
+    const Result* leader = nullptr;
+    for (const Result& each : results) {
+      if (each.instance == 0) {
+        leader = &each;
+      }
+    }
+    if (leader == nullptr) {
+      printf("A start of the leader is missing\n");
+      passed = false;
+      continue;
+    }
+    double startError = 0;
+    double laterError = 0;
+    bool sameFrames = true;
+    for (const Result& each : results) {
+      startError = fmax(startError, fabs(each.startedUs - leader->startedUs) / 1000.0);
+      laterError = fmax(laterError, fabs(each.laterUs - leader->laterUs) / 1000.0);
+      sameFrames &= each.checksum == leader->checksum;
+    }
+    const bool complete = results.size() == WiFiUDP::instances;
+    printf("%-6u %9zu %18.3f %18.3f %9s\n", round++, results.size(), startError, laterError, sameFrames ? "same" : "differ");
+    passed &= complete && sameFrames && startError * 1000 < FRAME_US && laterError * 1000 < FRAME_US;
+  }
+  passed &= round == ROUNDS;
+  printf("%s: %d followers %s within a frame of the leader\n", passed ? "PASS" : "FAIL", followers, passed ? "stayed" : "did not stay");
+  return passed ? 0 : 1;
+}
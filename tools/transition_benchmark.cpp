@@ -0,0 +1,113 @@
+// Measures the transitions between two animations on the host and checks
+// that the batched blend matches the blend of single channel bytes:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -DTRANSITIONS_AVAILABLE -Itools/simulator -Iinclude
+//     tools/transition_benchmark.cpp src/transition.cpp src/leds.cpp src/random.cpp src/animation.cpp
+//     -o transition_benchmark
+//   ./transition_benchmark
+//
+// A transition frame copies both canvases in and out of leds[] and blends
+// them, without the steps of the animations. The work grows linearly with
+// the number of LEDs, so the time is also given for 300 LEDs and as share of
+// the 10 ms frame tick. The host is much faster than an ESP32, so the ratio
+// between the batched and the per LED blend is more meaningful than the
+// absolute times.
+#include <chrono>
+#include <cstdio>
+
+#include "transition.hpp"
+
+SimulatedSerial Serial;
+
+namespace {
+
+constexpr uint32_t REPETITIONS = 200000;
+constexpr uint16_t LARGE_STRIP = 300;
+constexpr double FRAME_NS = 10e6;
+
+// Keeps the canvas it was started with
+class StillAnimation : public Animation {
+public:
+  virtual bool finished() override { return false; }
+  ANIMATIONNAME("Still")
+protected:
+  virtual bool calculateFrame() override { return false; }
+};
+
+template<class Frame>
+double measure(Frame frame) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < REPETITIONS; i++) {
+    frame(i);
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / REPETITIONS;
+}
+
+void print(const char* name, double ns) {
+  const double largeNs = ns * LARGE_STRIP / NUM_LEDS;
+  printf("%-26s %8.1f ns for %u LEDs, %8.1f ns for %u LEDs (%.3f%% of a frame)\n",
+         name, ns, NUM_LEDS, largeNs, LARGE_STRIP, largeNs / FRAME_NS * 100);
+}
+
+void fillRandom(CRGB* frame) {
+  for (uint8_t led = 0; led < NUM_LEDS; led++) {
+    frame[led] = CRGB(randomByte(), randomByte(), randomByte());
+  }
+}
+
+// Every amount must give the same bytes as blending each byte on its own
+bool blendMatches() {
+  alignas(4) CRGB from[NUM_LEDS];
+  alignas(4) CRGB to[NUM_LEDS];
+  alignas(4) CRGB output[NUM_LEDS];
+  fillRandom(from);
+  fillRandom(to);
+  for (uint16_t amount = 0; amount <= 256; amount++) {
+    blendFrames(from, to, output, amount);
+    const uint8_t* fromBytes = reinterpret_cast<const uint8_t*>(from);
+    const uint8_t* toBytes = reinterpret_cast<const uint8_t*>(to);
+    const uint8_t* outputBytes = reinterpret_cast<const uint8_t*>(output);
+    for (uint16_t i = 0; i < sizeof(output); i++) {
+      if (outputBytes[i] != ((fromBytes[i] * (256 - amount) + toBytes[i] * amount) >> 8)) {
+        printf("Byte %u differs at amount %u\n", i, amount);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Runs a whole transition again and again, each with a random style
+double measureTransition() {
+  StillAnimation outgoing;
+  StillAnimation incoming;
+  Transition transition;
+  return measure([&](uint32_t) {
+    if (!transition.active()) {
+      transition.begin(&outgoing);
+    }
+    transition.frame(incoming);
+  });
+}
+
+}
+
+int main() {
+  seedRandom(1);
+  fillRandom(leds);
+  alignas(4) CRGB from[NUM_LEDS];
+  alignas(4) CRGB to[NUM_LEDS];
+  fillRandom(from);
+  fillRandom(to);
+
+  const bool matches = blendMatches();
+  print("Batched blend", measure([&](uint32_t i) { blendFrames(from, to, leds, i & 0xff); }));
+  print("blend() per LED", measure([&](uint32_t i) {
+    for (uint8_t led = 0; led < NUM_LEDS; led++) {
+      leds[led] = blend(from[led], to[led], i & 0xff);
+    }
+  }));
+  print("Transition frame", measureTransition());
+  printf("The batched blend %s the blend of single bytes\n", matches ? "matches" : "does not match");
+  return matches ? 0 : 1;
+}
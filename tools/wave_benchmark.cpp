@@ -0,0 +1,90 @@
+// Measures the steps of the wave animations on the host, with the Arduino and
+// FastLED parts of the simulator:
+//
+//   g++ -O2 -std=gnu++11 -DSIMULATOR -Itools/simulator -Iinclude tools/wave_benchmark.cpp
+//     src/waves.cpp src/leds.cpp src/random.cpp src/animation.cpp -o wave_benchmark
+//   ./wave_benchmark
+//
+// The cycles are the ones of the host's time stamp counter. For comparison a
+// wave with sinf() for every LED is measured as well; on an Uno without a
+// floating point unit the difference is far larger than on the host.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_AVAILABLE
+#endif
+
+#include "animationbuffer.hpp"
+#include "waves.hpp"
+
+namespace {
+
+constexpr uint32_t STEPS = 20000;
+
+struct Measurement {
+  double ns;
+  double cycles;
+};
+
+template<class Step>
+Measurement measure(Step step) {
+#ifdef CYCLES_AVAILABLE
+  const uint64_t startCycles = __rdtsc();
+#endif
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < STEPS; i++) {
+    step();
+  }
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  Measurement measurement { ns / STEPS / NUM_LEDS, 0 };
+#ifdef CYCLES_AVAILABLE
+  measurement.cycles = (double)(__rdtsc() - startCycles) / STEPS / NUM_LEDS;
+#endif
+  return measurement;
+}
+
+void print(const char* name, const Measurement& measurement) {
+  printf("%-24s %6.2f ns %6.1f cycles per LED and step\n", name, measurement.ns, measurement.cycles);
+}
+
+// Steps the animation, a finished one is created again
+template<class T>
+Measurement measureAnimation() {
+  AnimationBuffer buffer;
+  buffer.create<T>();
+  return measure([&buffer]() {
+    Animation* animation = buffer.get();
+    while (!animation->frame()) {
+      if (animation->finished()) {
+        buffer.create<T>();
+        animation = buffer.get();
+      }
+    }
+  });
+}
+
+// WavingColors with the sine calculated for every LED
+Measurement measureFloatWave() {
+  float phase = 0;
+  return measure([&phase]() {
+    for (uint8_t led = 0; led < NUM_LEDS; led++) {
+      const float position = 2 * (float)M_PI * led / NUM_LEDS;
+      const float amount = (sinf(position * 2 + phase) + sinf(position * 5 - phase * 1.5f)) * 0.25f + 0.5f;
+      leds[led] = blend(CRGB::Red, CRGB::Green, amount * 0xff);
+    }
+    phase += 0.01f;
+  });
+}
+
+}
+
+int main() {
+  seedRandom(1);
+  print(WavingColors::NAME, measureAnimation<WavingColors>());
+  print(ShootingStars::NAME, measureAnimation<ShootingStars>());
+  print("sinf() per LED", measureFloatWave());
+  return 0;
+}